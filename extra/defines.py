@@ -1,8 +1,7 @@
-from rich import inspect
-
 Import("env")
 
-board = env.BoardConfig()
+board_id = env.get("BOARD")
+board = env.BoardConfig() if board_id else {}  # native has no board
 
 def as_int(v, default=0):
     if v is None:
@@ -16,16 +15,24 @@ mcu        = board.get("build.mcu")
 f_cpu      = as_int(board.get("build.f_cpu"))
 flash_max  = as_int(board.get("upload.maximum_size"))
 ram_max    = as_int(board.get("upload.maximum_ram_size"))
-board_id   = env["BOARD"]
 platform   = env.PioPlatform().name
+board_id   = board_id or platform
 
 env.Append(
     CPPDEFINES=[
         ("PIO_PLATFORM",        f'\\"{platform}\\"'),
         ("PIO_BOARD",           f'\\"{board_id}\\"'),
-        ("HW_MCU",              f'\\"{mcu or ''}\\"'),
+        ("HW_MCU",              f'\\"{mcu or ""}\\"'),
         ("HW_F_CPU",            f_cpu),
         ("HW_FLASH_BYTES",      flash_max),
         ("HW_RAM_BYTES",        ram_max),
     ]
 )
+
+# alloc_tracker.cpp only gets called if the allocator is wrapped at link time
+if "ENABLE_ALLOC_TRACKING" in str(env.GetProjectOption("build_flags", "")):
+    if platform == "native":
+        wrapped = ["malloc", "free", "realloc", "calloc"]   # glibc
+    else:
+        wrapped = ["_malloc_r", "_free_r"]                  # newlib, below arduino-pico's malloc lock
+    env.Append(LINKFLAGS=[f"-Wl,--wrap={fn}" for fn in wrapped])
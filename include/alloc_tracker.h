@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "delegate.h"
+
+// Heap profiler. Needs -D ENABLE_ALLOC_TRACKING and the allocator hooks linked in
+// (extra/defines.py adds them for any env that sets the define: env:pico-alloc, env:native):
+//   newlib (device): -Wl,--wrap=_malloc_r -Wl,--wrap=_free_r
+//   glibc (host):    -Wl,--wrap=malloc -Wl,--wrap=free -Wl,--wrap=realloc -Wl,--wrap=calloc
+// The newlib hooks sit below malloc(), so they also work on arduino-pico, which
+// wraps malloc() itself for its multicore lock. operator new/delete are replaced
+// too, to record who called them.
+//
+// Allocations are attributed to the innermost ALLOC_SCOPE of the calling core.
+
+#define ALLOC_SITES     16  // call sites tracked, the least frequent one is evicted
+
+enum class AllocTag : uint8_t {
+    OTHER, RENDER, KEYS, RX, TX, COUNT
+};
+
+struct AllocStats {
+    uint32_t allocs = 0;
+    uint32_t frees = 0;
+    uint32_t bytes = 0;     // total allocated
+    uint32_t scopes = 0;    // times the scope was entered
+    uint32_t worst = 0;     // most allocations within one scope
+    uint32_t peak = 0;      // largest heap growth within one scope
+    uint32_t budget = 0;    // allocations allowed per scope, 0 = unchecked
+    uint32_t overruns = 0;
+};
+
+struct AllocSite {
+    uintptr_t addr = 0;
+    uint32_t count = 0;
+    uint32_t bytes = 0;
+};
+
+class AllocTracker {
+    friend class AllocScope;
+public:
+    using OverBudget = Delegate<void(AllocTag, uint32_t)>;
+
+    static void record(size_t size, const void* site);  // from the hooks only
+    static void release(size_t size);
+
+    static void budget(AllocTag tag, uint32_t allocs);
+    static void onOverBudget(OverBudget fn);
+    static void reset();
+
+    [[nodiscard]] static const AllocStats& stats(AllocTag tag);
+    [[nodiscard]] static uint32_t liveBytes();
+    [[nodiscard]] static uint32_t peakBytes();
+    [[nodiscard]] static uint8_t topSites(AllocSite* out, uint8_t n); // by count
+    [[nodiscard]] static const char* tagName(AllocTag tag);
+};
+
+class AllocScope {
+    AllocTag prev_tag;
+    uint32_t prev_max;
+    uint32_t allocs_at;
+    uint32_t live_at;
+public:
+    explicit AllocScope(AllocTag tag);
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+#ifdef ENABLE_ALLOC_TRACKING
+#define ALLOC_SCOPE_CONCAT_(a, b)   a##b
+#define ALLOC_SCOPE_CONCAT(a, b)    ALLOC_SCOPE_CONCAT_(a, b)
+#define ALLOC_SCOPE(tag)            AllocScope ALLOC_SCOPE_CONCAT(alloc_scope_, __LINE__){tag}
+#else
+#define ALLOC_SCOPE(tag)            ((void)0)
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+#define BOOT_STAGES     12
+
+// Timestamps of the boot stages, in microseconds since reset.
+class BootLog {
+    const char* names[BOOT_STAGES]{};
+    uint32_t times[BOOT_STAGES]{};
+    uint8_t count = 0;
+public:
+    void mark(const char* stage, uint32_t now_us) {
+        if (count >= BOOT_STAGES) return;
+        names[count] = stage;
+        times[count++] = now_us;
+    }
+
+    [[nodiscard]] uint8_t stages() const            { return count; }
+    [[nodiscard]] const char* name(uint8_t i) const { return names[i]; }
+    [[nodiscard]] uint32_t at(uint8_t i) const      { return times[i]; }
+    [[nodiscard]] uint32_t took(uint8_t i) const    { return times[i] - (i ? times[i-1] : 0); }
+};
@@ -38,12 +38,26 @@
 #define DISPLAY_ADDRESS     0x3C
 #define KEYBOARD_ADDRESS    0x5F
 
+#ifndef KEYBOARD_INT
+#define KEYBOARD_INT        -1  // data-ready line of the keyboard, -1 = not wired (polling)
+#endif
+
 
 /****************/
 /**** Consts ****/
 /****************/
-#define MESSAGE_LENGTH 128
-#define DISPLAY_FPS 1
+#define MESSAGE_LENGTH 128  // on air, sizes the TDMA slots: the same on every node
+#if defined(ARDUINO_ARCH_STM32)
+#define MESSAGE_HISTORY 16  // sent messages kept for the broadcast tab, oldest dropped first
+#define MESSAGE_LOG_LENGTH 64   // per kept message; rows are cut to the screen width anyway
+#else
+#define MESSAGE_HISTORY 32
+#define MESSAGE_LOG_LENGTH MESSAGE_LENGTH
+#endif
+#define BAND_START 863.000
+#define BAND_END   870.000
+#define ALLOC_BUDGET_RENDER 0   // allocations per frame with ENABLE_ALLOC_TRACKING, 0 = unchecked
+#define ALLOC_BUDGET_KEYS   0
 
 
 /*****************/
@@ -68,16 +82,26 @@
 #error "Unknown display. Define in `configuration.h`"
 #endif
 
+#ifndef DISPLAY_MAX_FPS
+#define DISPLAY_MAX_FPS     10  // cap for animations; input always renders right away
+#endif
+
 
 /******************/
 /**** Hardware ****/
 /******************/
 #if  defined(ARDUINO_ARCH_RP2040)
 #include "hw_impl/hw_rp2040.h"
+#ifndef SINGLE_CORE
+#define DUAL_CORE   // radio + NetManager on core1, UI and input on core0
+#endif
 
 #elif defined(ARDUINO_ARCH_STM32)
 #include "hw_impl/hw_stm32.h"
 
+#elif !defined(ARDUINO)
+// host build (env:native unit tests), no driver
+
 #else
 #error "Unknown platform. Define in `configuration.h`"
 #endif
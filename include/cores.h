@@ -0,0 +1,8 @@
+#pragma once
+
+// Second execution context for the radio side. arduino-pico already runs
+// setup1()/loop1() on core1, so there it's only a wake-up primitive; the host
+// backend runs the same pair on a pthread to stress-test the split on Linux.
+void startRadioCore(void (*setup)(), void (*loop)());
+void stopRadioCore();
+void wakeCores();   // after queueing something for the other side
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#define DELEGATE_SIZE (2 * sizeof(void*))
+
+// std::function replacement for callbacks: the callable lives inline, so building
+// and calling one never allocates. Captures have to fit into Size and be trivially
+// copyable (pointers, numbers, other delegates) - both are checked at compile time.
+template<typename Signature, size_t Size = DELEGATE_SIZE>
+class Delegate;
+
+template<typename R, typename... Args, size_t Size>
+class Delegate<R(Args...), Size> {
+    using Invoker = R(*)(void*, Args...);
+
+    alignas(std::max_align_t) mutable unsigned char storage[Size]{};
+    Invoker invoker = nullptr;
+
+    template<typename F>
+    static R invoke(void* callable, Args... args) {
+        return (*static_cast<F*>(callable))(std::forward<Args>(args)...);
+    }
+
+public:
+    Delegate() = default;
+    Delegate(std::nullptr_t) {}
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate>>>
+    Delegate(F f) { // implicit on purpose, lambdas are passed straight into builders
+        static_assert(sizeof(F) <= Size, "Capture is too big for this Delegate, pass pointers or raise Size");
+        static_assert(alignof(F) <= alignof(std::max_align_t), "Capture is over-aligned");
+        static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+                      "Delegate captures must be trivially copyable");
+
+        new (storage) F(f);
+        invoker = &invoke<F>;
+    }
+
+    R operator()(Args... args) const { return invoker(storage, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return invoker != nullptr; }
+};
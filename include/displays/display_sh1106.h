@@ -3,11 +3,40 @@
 
 #include <Adafruit_SH110X.h>
 
-typedef Adafruit_SH1106G DisplayType;
+#include "displays/glyph_blitter.h"
+#include "displays/page_flusher.h"
+#include "displays/pattern_fill.h"
+
+#define SH1106_COLUMN_OFFSET 2 // 128 visible columns centered in the controller's 132
+
+// Sends only the changed parts of each page instead of the whole framebuffer
+class Partial_SH1106G : public Adafruit_SH1106G {
+    PageFlusher flusher;
+    int16_t scroll_hint = 0;
+
+public:
+    Partial_SH1106G(uint16_t w, uint16_t h, TwoWire* twi = &Wire, int8_t rst_pin = -1)
+        : Adafruit_SH1106G(w, h, twi, rst_pin), flusher(w, h) {}
+
+    bool begin(uint8_t addr = 0x3C, bool reset = true) {
+        flusher.invalidate();
+        return Adafruit_SH1106G::begin(addr, reset);
+    }
+    void display();
+    void drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg); // drawChar() at size 1, straight into the buffer
+    void fillChecker(uint16_t color); // every other pixel, see PatternFill
+    void scrolled(int16_t dy) { scroll_hint += dy; } // content moved up by dy pixels, display() may move the start line
+};
+
+typedef Partial_SH1106G DisplayType;
 extern DisplayType display;
 #define HAS_CONTRAST
 inline void setContrast(uint8_t contrast) { display.setContrast(contrast); }
 #define THEME (UITheme{SH110X_WHITE, SH110X_BLACK})
 #define DISPLAY_MODE DISPLAY_MODE_BUFFERED
+#define DISPLAY_MAX_FPS 30
+#define HAS_GLYPH_BLIT
+#define HAS_PATTERN_FILL
+#define HAS_HW_SCROLL
 
-#endif
\ No newline at end of file
+#endif
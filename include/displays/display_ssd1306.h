@@ -3,7 +3,32 @@
 
 #include <Adafruit_SSD1306.h>
 
-typedef Adafruit_SSD1306 DisplayType;
+#include "displays/glyph_blitter.h"
+#include "displays/page_flusher.h"
+#include "displays/pattern_fill.h"
+
+#define SSD1306_WIRE_CHUNK 31 // Wire buffer minus the data control byte
+
+// Sends only the changed parts of each page instead of the whole framebuffer
+class Partial_SSD1306 : public Adafruit_SSD1306 {
+    PageFlusher flusher;
+    int16_t scroll_hint = 0;
+
+public:
+    Partial_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rst_pin = -1)
+        : Adafruit_SSD1306(w, h, twi, rst_pin), flusher(w, h) {}
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0, bool reset = true, bool periph_begin = true) {
+        flusher.invalidate();
+        return Adafruit_SSD1306::begin(switchvcc, i2caddr, reset, periph_begin);
+    }
+    void display();
+    void drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg); // drawChar() at size 1, straight into the buffer
+    void fillChecker(uint16_t color); // every other pixel, see PatternFill
+    void scrolled(int16_t dy) { scroll_hint += dy; } // content moved up by dy pixels, display() may move the start line
+};
+
+typedef Partial_SSD1306 DisplayType;
 extern DisplayType display;
 #define HAS_CONTRAST
 inline void setContrast(uint8_t contrast) {
@@ -12,5 +37,9 @@ inline void setContrast(uint8_t contrast) {
 }
 #define THEME (UITheme{SSD1306_WHITE, SSD1306_BLACK})
 #define DISPLAY_MODE DISPLAY_MODE_BUFFERED
+#define DISPLAY_MAX_FPS 30
+#define HAS_GLYPH_BLIT
+#define HAS_PATTERN_FILL
+#define HAS_HW_SCROLL
 
-#endif
\ No newline at end of file
+#endif
@@ -3,24 +3,107 @@
 
 #include <Adafruit_SSD1351.h>
 
-// TODO: specify 1-8-16
-class Buffered_SSD1351 : public GFXcanvas16 {
+#include "displays/glyph_blitter.h"
+#include "displays/indexed_canvas.h"
+#include "displays/pattern_fill.h"
+
+// Frames leave through DMA where the bus is known; render() returns as soon as the
+// transfer is kicked off and the main loop (and radio) keep running meanwhile.
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/spi.h>
+#define SSD1351_DMA
+#elif defined(ARDUINO_ARCH_STM32) && defined(STM32F4xx)
+#define SSD1351_DMA // SPI2 TX on DMA1 stream 4
+#endif
+
+// Bits per pixel of the framebuffer: 16 (RGB565, 32 KB), 8 (RGB332, 16 KB) or 4 (16-color palette, 8 KB)
+#ifndef SSD1351_DEPTH
+#if defined(ARDUINO_ARCH_RP2040)
+#define SSD1351_DEPTH 16
+#else
+#define SSD1351_DEPTH 8     // the F446 has better uses for 16 KB
+#endif
+#endif
+
+#ifndef SSD1351_BUFFERS
+#if defined(ARDUINO_ARCH_RP2040)
+#define SSD1351_BUFFERS 2   // render the next frame while the last one is sent
+#else
+#define SSD1351_BUFFERS 1   // 32 KB more is too much for 128 KB parts
+#endif
+#endif
+
+#if   SSD1351_DEPTH == 16
+typedef GFXcanvas16 SSD1351Canvas;
+#elif SSD1351_DEPTH == 8
+typedef IndexedCanvas8 SSD1351Canvas;
+#elif SSD1351_DEPTH == 4
+typedef IndexedCanvas4 SSD1351Canvas;
+#else
+#error "SSD1351_DEPTH must be 16, 8 or 4"
+#endif
+
+#ifdef SSD1351_DMA
+#define DISPLAY_ASYNC_FLUSH
+#endif
+
+class Buffered_SSD1351 : public SSD1351Canvas {
     Adafruit_SSD1351 _display;
+    SPIClass* spi = nullptr;        // hardware bus, nullptr with software SPI
+    bool dma = false;               // only on a bus the radio doesn't share
+    bool sending = false;
+    bool reading_canvas = false;    // the transfer in flight reads `buffer` itself
+#if SSD1351_DEPTH == 16
+    uint16_t* spare = nullptr;      // second frame with SSD1351_BUFFERS > 1
+#else
+    uint16_t* lines = nullptr;      // two expanded rows, one filling while the other is sent
+    volatile uint16_t next_row = 0; // rows handed to DMA, the transfer-complete IRQ queues the rest
+    void feed();
+#endif
+#if defined(SSD1351_DMA) && defined(ARDUINO_ARCH_RP2040)
+    spi_inst_t* spi_hw = nullptr;
+    int dma_channel = -1;
+#endif
+
+    void beginTransfer();
+    void queue(const uint16_t* pixels, uint32_t count);
+    bool queueIdle() const;         // DMA is done reading memory, the SPI FIFO may still drain
+    bool transferDone() const;
+    void finishTransfer();
 
 public:
     Buffered_SSD1351(uint16_t width, uint16_t height, int8_t cs_pin,
                      int8_t dc_pin, int8_t mosi_pin, int8_t sclk_pin,
                      int8_t rst_pin = -1)
-        : GFXcanvas16(width, height, true),
+        : SSD1351Canvas(width, height),
           _display(width, height, cs_pin, dc_pin, mosi_pin, sclk_pin, rst_pin) {}
 
     Buffered_SSD1351(uint16_t width, uint16_t height, SPIClass *spi,
                      int8_t cs_pin, int8_t dc_pin, int8_t rst_pin = -1)
-        : GFXcanvas16(width, height, true),
-          _display(width, height, spi, cs_pin, dc_pin, rst_pin) {}
+        : SSD1351Canvas(width, height),
+          _display(width, height, spi, cs_pin, dc_pin, rst_pin), spi(spi) {}
+
+    ~Buffered_SSD1351();
+
+    void begin();
+    void display();     // starts sending the frame, returns before it is out
+
+#if SSD1351_DEPTH != 16
+    static void lineSent(); // DMA transfer-complete IRQ
+#endif
+
+    bool busy();        // polls the transfer, releases the bus once it is done
+    void wait();        // blocks until the transfer in flight is done
+    void fence();       // blocks until `buffer` may be drawn into again
 
-    void begin() { _display.begin(); }
-    void display();
+#if SSD1351_DEPTH == 16
+    void drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg); // drawChar() at size 1, straight into the buffer
+#endif
+#if SSD1351_DEPTH != 4
+    void fillChecker(uint16_t color); // every other pixel, see PatternFill
+#endif
 };
 
 typedef Buffered_SSD1351 DisplayType;
@@ -32,6 +115,13 @@ extern DisplayType display;
 // }
 #define THEME (UITheme{0x1FF1, 0x0000})
 #define DISPLAY_MODE DISPLAY_MODE_BUFFERED
+#define DISPLAY_MAX_FPS 30
 #define HAS_COLOR
+#if SSD1351_DEPTH == 16
+#define HAS_GLYPH_BLIT
+#endif
+#if SSD1351_DEPTH != 4
+#define HAS_PATTERN_FILL
+#endif
 
 #endif
@@ -3,9 +3,25 @@
 
 #include <GxEPD2_BW.h>
 
-typedef GxEPD2_BW<GxEPD2_154_D67, GxEPD2_154_D67::HEIGHT> DisplayType;
+#define SSD1681_GHOST_LIMIT 400 // % of the screen partial refreshes may cover before a full one clears the ghosting
+#define SSD1681_GHOST_MIN   10  // % charged for a partial refresh however small it is
+
+// The buffer holds the whole frame (one page), so a frame is drawn once and only the
+// window that changed is sent. Partial refreshes leave ghosting behind in proportion to
+// the area they cover; once enough has built up, the next refresh is a full one.
+class Partial_SSD1681 : public GxEPD2_BW<GxEPD2_154_D67, GxEPD2_154_D67::HEIGHT> {
+    uint16_t ghosting = SSD1681_GHOST_LIMIT; // panel content is unknown until the first full refresh
+
+public:
+    explicit Partial_SSD1681(const GxEPD2_154_D67& epd) : GxEPD2_BW(epd) {}
+
+    void refreshWindow(int16_t x, int16_t y, int16_t w, int16_t h, bool full = false); // rotated coordinates
+};
+
+typedef Partial_SSD1681 DisplayType;
 extern DisplayType display;
 #define THEME (UITheme{GxEPD_BLACK, GxEPD_WHITE})
 #define DISPLAY_MODE DISPLAY_MODE_EINK
+#define DISPLAY_MAX_FPS 1
 
-#endif
\ No newline at end of file
+#endif
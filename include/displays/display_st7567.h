@@ -12,5 +12,6 @@ inline void setContrast(uint8_t contrast) { display.setContrast(contrast); }
 inline void setBacklight(uint8_t brightness) { analogWrite(DISPLAY_BL, brightness); }
 #define THEME (UITheme{BLACK, WHITE})
 #define DISPLAY_MODE DISPLAY_MODE_BUFFERED
+#define DISPLAY_MAX_FPS 60
 
 #endif
\ No newline at end of file
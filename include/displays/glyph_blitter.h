@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Draws a character of the built-in 5x7 font (6x8 cell) straight into a framebuffer,
+// a glyph column or row at a time instead of one clipped writePixel() per dot.
+// Both return false when they can't take the glyph (partly off screen, inverse
+// ink on the 1-bit panels); the caller falls back to drawChar() then.
+// `w`, `h` and `rotation` describe the buffer like Adafruit_GFX does: raw size and
+// rotation, with x/y in rotated coordinates. fg == bg leaves the background alone.
+class GlyphBlitter {
+public:
+    // 1-bit, page-organized: one byte per column per 8 rows, LSB on top (SH1106, SSD1306, ST7567)
+    static bool pages(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation,
+                      int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg);
+
+    // 16-bit, row-major RGB565 canvas (GFXcanvas16)
+    static bool rgb565(uint16_t* buf, int16_t w, int16_t h, uint8_t rotation,
+                       int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg);
+
+    // column i (0-5, the last one is the blank gap) of glyph c, LSB on top
+    static uint8_t column(uint8_t c, uint8_t i);
+};
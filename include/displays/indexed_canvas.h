@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+// Canvases that store a palette index per pixel instead of RGB565. Drawing still takes
+// RGB565 colors; they are mapped on the way in and expanded back one raw (unrotated)
+// row at a time by expandLine(), which is what the flush streams to the panel.
+
+// 8bpp, fixed RGB332 palette: every color maps, at 3-3-2 bits of precision.
+class IndexedCanvas8 : public GFXcanvas8 {
+public:
+    IndexedCanvas8(uint16_t w, uint16_t h) : GFXcanvas8(w, h) {}
+
+    static uint8_t index(uint16_t color) {
+        return (color >> 8 & 0xE0) | (color >> 6 & 0x1C) | (color >> 3 & 0x03);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+
+    void expandLine(uint16_t y, uint16_t* out) const;
+};
+
+
+// 4bpp, 16 colors picked up as they are drawn. Exact colors for the handful a theme
+// uses; once full, new colors fall back to the nearest entry. A full clear starts over.
+class IndexedCanvas4 : public Adafruit_GFX {
+    uint8_t* buffer;
+    uint16_t palette[16] = {};
+    uint8_t used = 0;
+    uint16_t last_color = 0;    // most drawing repeats the previous color
+    uint8_t last_index = 0;
+
+    uint32_t pairs[256] = {};   // two expanded pixels per packed byte
+    bool pairs_valid = false;
+
+    uint8_t nearest(uint16_t color) const;
+public:
+    IndexedCanvas4(uint16_t w, uint16_t h);
+    ~IndexedCanvas4() { delete[] buffer; }
+
+    uint8_t index(uint16_t color);
+    uint8_t paletteSize() const { return used; }
+    uint8_t* getBuffer() const { return buffer; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    void expandLine(uint16_t y, uint16_t* out);
+};
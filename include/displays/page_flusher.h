@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include "delegate.h"
+
+#define PAGE_FLUSH_GAP  6   // unchanged bytes cheaper to resend than a new page/column address
+
+// Shadow copy of what a page-addressed monochrome panel (SH1106, SSD1306, ST7567) shows.
+// flush() compares a frame against it and hands only the changed column runs of each
+// 8-pixel page to the driver. Same layout as the Adafruit 1-bit buffers: page-major,
+// one byte per column.
+// The shadow is kept in panel RAM order. With a display start line, frame page p lives
+// in RAM page (p + start) % pages, so a list scrolled by whole pages can be shown by
+// moving the start line and sending only what scrolled in.
+class PageFlusher {
+    uint8_t* shadow;
+    uint16_t width;
+    uint8_t pages;
+    uint8_t start = 0;
+    bool valid = false;
+
+    uint16_t cost(const uint8_t* frame, uint8_t from) const; // bytes that differ with RAM page `from` on top
+public:
+    using Sink = Delegate<void(uint8_t page, uint8_t col, const uint8_t* data, uint8_t len)>;
+
+    PageFlusher(uint16_t width, uint16_t height)
+        : shadow(new uint8_t[width * ((height + 7) / 8)]), width(width), pages((height + 7) / 8) {}
+    ~PageFlusher() { delete[] shadow; }
+
+    void invalidate() { valid = false; start = 0; } // panel RAM unknown and not scrolled, the next flush sends everything
+    uint16_t flush(const uint8_t* frame, Sink sink); // returns the number of data bytes sent
+
+    // the frame's content moved up by `by` pages (down if negative): takes the start page
+    // that shows it if that leaves less to send. True when the start page changed
+    bool scroll(const uint8_t* frame, int8_t by);
+    [[nodiscard]] uint8_t startPage() const { return start; }
+};
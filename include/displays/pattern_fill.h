@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+// Covers a whole framebuffer with a 50% checkerboard of one color, the pixels where
+// x + y is odd in rotated coordinates (what a writePixel() loop over the screen does),
+// without going through the per-pixel virtual calls. The other half stays as it is.
+// `w`, `h` and `rotation` describe the buffer like Adafruit_GFX does: raw size and rotation.
+class PatternFill {
+public:
+    // 1-bit, page-organized: one byte per column per 8 rows, LSB on top (SH1106, SSD1306, ST7567).
+    // color 0 clears, 1 sets, 2 inverts, like the Adafruit monochrome drivers
+    static void pages(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation, uint16_t color);
+
+    // 8-bit, row-major, color already mapped to a buffer value (GFXcanvas8, IndexedCanvas8)
+    static void bytes(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation, uint8_t value);
+
+    // 16-bit, row-major RGB565 canvas (GFXcanvas16)
+    static void rgb565(uint16_t* buf, int16_t w, int16_t h, uint8_t rotation, uint16_t color);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "delegate.h"
+#include "ring_buffer.h"
+
+#define EVENT_QUEUE_SIZE    16
+#define EVENT_TIMERS        8
+#define EVENT_NO_TIMER      (-1)
+#define EVENT_MAX_SLEEP     1000    // ms; upper bound for a single idle period
+
+enum class EventType : uint8_t {
+    NONE, KEY, RADIO, REFRESH, COUNT
+};
+
+struct Event {
+    EventType type = EventType::NONE;
+    char key = 0;
+    uint32_t time = 0;              // millis() when posted
+};
+
+// Events come either from the main loop (post) or from ISRs (signal, one pending
+// bit per type). Timers are kept ordered by deadline; when nothing is due the
+// loop sleeps in driver->idle() until the next deadline or interrupt.
+class EventLoop {
+public:
+    using Handler = Delegate<void(const Event&)>;
+
+private:
+    struct Timer {
+        uint32_t deadline = 0;
+        uint32_t period = 0;        // 0 = one-shot
+        bool active = false;
+        Delegate<void()> fn{};
+    };
+
+    RingBuffer<Event, EVENT_QUEUE_SIZE> queue{};
+    Handler handlers[static_cast<uint8_t>(EventType::COUNT)]{};
+    Timer timers[EVENT_TIMERS]{};
+    int8_t order[EVENT_TIMERS]{};   // active timer ids, earliest deadline first
+    uint8_t active = 0;
+    volatile uint32_t signals = 0;
+
+    void insert(int8_t id);
+    void remove(int8_t id);
+    int8_t schedule(uint32_t delay, uint32_t period, Delegate<void()> fn);
+    void dispatch(const Event& e);
+public:
+    void on(EventType type, Handler handler)    { handlers[static_cast<uint8_t>(type)] = handler; }
+
+    bool post(const Event& e);
+    bool post(EventType type)                   { return post(Event{type, 0, millis()}); }
+    void signal(EventType type);                // ISR-safe
+
+    int8_t after(uint32_t ms, Delegate<void()> fn)  { return schedule(ms, 0, fn); }
+    int8_t every(uint32_t ms, Delegate<void()> fn)  { return schedule(ms, ms, fn); }
+    void reschedule(int8_t id, uint32_t ms);
+    void cancel(int8_t id);
+    [[nodiscard]] bool scheduled(int8_t id) const   { return id >= 0 && id < EVENT_TIMERS && timers[id].active; }
+
+    [[nodiscard]] uint32_t untilNext(uint32_t now) const;
+
+    void run();
+};
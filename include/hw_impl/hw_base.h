@@ -23,4 +23,26 @@ public:
 
     virtual void init() = 0;
     virtual void reboot() = 0;
+
+    virtual void idle(uint32_t us) {} // sleep until an interrupt, wake() or at most `us`
+    virtual void wake() {}            // ISR-safe; makes a pending/next idle() return
+
+    // memory telemetry in bytes, 0 where the platform can't tell
+    virtual uint32_t freeHeap() const { return 0; }          // what malloc can still hand out in total
+    virtual uint32_t largestFreeBlock() const { return 0; }  // biggest single malloc that fits right now
+    virtual uint32_t heapHighWater() const { return 0; }     // heap footprint peak, sbrk never gives back
+
+    virtual uint8_t cores() const { return 1; }
+    virtual uint32_t stackSize(uint8_t core) const { return 0; }
+    virtual uint32_t stackHighWater(uint8_t core) const { return 0; } // deepest use since paintStack()
+    virtual void paintStack() {} // call on each core, as early as possible
+
+protected:
+    // newlib helpers for the MCU drivers
+    static uint32_t heapUsed();
+    static uint32_t heapArena();
+    static uint32_t heapFree(uintptr_t limit);
+    static uint32_t heapLargest(uintptr_t limit);
+    static void fillStack(uint32_t* bottom);
+    static uint32_t stackUsed(const uint32_t* bottom, const uint32_t* top);
 };
\ No newline at end of file
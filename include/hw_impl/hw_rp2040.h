@@ -42,6 +42,18 @@ public:
 
     void init() override;
     void reboot() override;
+
+    void idle(uint32_t us) override;
+    void wake() override;
+
+    uint32_t freeHeap() const override;
+    uint32_t largestFreeBlock() const override;
+    uint32_t heapHighWater() const override;
+
+    uint8_t cores() const override { return 2; }
+    uint32_t stackSize(uint8_t core) const override;
+    uint32_t stackHighWater(uint8_t core) const override;
+    void paintStack() override;
 };
 
 
@@ -34,6 +34,7 @@ extern SPIClass*    extSPI1;
 /**** Driver ****/
 /****************/
 class DriverSTM32 : public DriverBase {
+    volatile bool woken = false;
 public:
     DriverSTM32() = default;
 
@@ -44,7 +45,18 @@ public:
     uint32_t boardId() const override;
 
     void init() override;
-    void reboot() override;;
+    void reboot() override;
+
+    void idle(uint32_t us) override;    // tickless, SysTick reload stretched up to 2^24 cycles
+    void wake() override;
+
+    uint32_t freeHeap() const override;
+    uint32_t largestFreeBlock() const override;
+    uint32_t heapHighWater() const override;
+
+    uint32_t stackSize(uint8_t core) const override;
+    uint32_t stackHighWater(uint8_t core) const override;
+    void paintStack() override;
 };
 
 #endif
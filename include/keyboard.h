@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Wire.h>
+
+#include "ring_buffer.h"
+
+#define KEYBOARD_POLL_FAST  10      // ms, while someone is typing
+#define KEYBOARD_POLL_SLOW  100     // ms, idle
+#define KEYBOARD_FAST_FOR   3000    // ms after the last key before slowing down
+#define KEYBOARD_BUFFER     32
+
+struct KeyEvent {
+    char key = 0;
+    uint32_t time = 0;              // millis() when read from the device
+};
+
+// CardKB-style I2C keyboard: every read returns one key or 0. Keys are drained
+// in bursts into a timestamped queue, either when the data-ready line fires or
+// on an adaptive poll interval when the line isn't wired.
+class Keyboard {
+    TwoWire* wire = nullptr;
+    uint8_t address = 0;
+    int16_t int_pin = -1;
+
+    RingBuffer<KeyEvent, KEYBOARD_BUFFER> keys{};
+    uint32_t last_key = 0;
+    uint16_t dropped = 0;
+public:
+    void begin(TwoWire* w, uint8_t addr, int16_t pin = -1, void (*isr)() = nullptr);
+
+    uint8_t read(uint32_t now);     // drains the device, returns the number of new keys
+    bool pop(KeyEvent& e)           { return keys.pop(e); }
+    [[nodiscard]] bool pending() const          { return !keys.empty(); }
+
+    [[nodiscard]] bool interruptDriven() const  { return int_pin >= 0; }
+    [[nodiscard]] uint32_t pollInterval(uint32_t now) const;
+    [[nodiscard]] uint16_t droppedKeys() const  { return dropped; }
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+// NOTE: same as tdma.h, kept platform-free for host simulations
+
+#define CHANNEL_MAX         32
+#define CHANNEL_NONE        0xFF
+#define CHANNEL_BUSY        0.5f    // CAD hit ratio above which a channel is skipped
+#define CHANNEL_ALPHA       0.2f
+
+// Splits the band into channels one bandwidth (+60% guard) wide and walks them in a
+// pseudo-random order derived from the network key. Channels overlapping the control
+// (rendezvous) frequency and channels marked busy are skipped.
+class ChannelPlan {
+    float start = 0;
+    float spacing = 0;
+    uint8_t count = 0;
+    uint8_t sequence[CHANNEL_MAX]{};
+    float occupancy[CHANNEL_MAX]{};
+    uint32_t reserved = 0;  // overlapping the control channel
+    uint32_t busy = 0;      // announced by the coordinator, what hop() skips
+    uint32_t next = 0;      // updateMask() result, goes out with the next beacon
+    uint32_t signature = 0; // identifies key, band and bandwidth, see id()
+public:
+    void configure(float band_start, float band_end, float bandwidth_khz, float control, uint32_t seed);
+    void clear()                                { count = 0; signature = 0; }
+
+    [[nodiscard]] uint8_t channels() const      { return count; }
+    [[nodiscard]] uint32_t id() const           { return signature; } // carried in beacons, 0 = no hopping
+    [[nodiscard]] float frequency(uint8_t ch) const
+                                                { return start + spacing * (ch + 0.5f); }
+    [[nodiscard]] float load(uint8_t ch) const  { return ch < count ? occupancy[ch] : 0; }
+    [[nodiscard]] bool usable(uint8_t ch) const { return ch < count && !((reserved | busy) >> ch & 1); }
+
+    [[nodiscard]] uint8_t hop(uint32_t frame) const;
+
+    [[nodiscard]] uint32_t busyMask() const     { return busy; }
+    [[nodiscard]] uint32_t nextMask() const     { return next; }
+    // coordinator, when sending a beacon: the pending mask goes live together with the announcement
+    uint32_t announce()                         { busy = next; return busy; }
+    // takes the coordinator's busy mask if it hops the same plan, otherwise blocks every channel
+    void adopt(uint32_t coordinator_id, uint32_t mask);
+
+    void sample(uint8_t ch, bool detected);
+    void updateMask();
+};
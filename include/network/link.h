@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "delegate.h"
+#include "ring_buffer.h"
+
+// NOTE: no Arduino here either, the UI <-> radio queues are shared with the host
+// (pthread) build of the threading layer.
+
+#define LINK_FRAME_MAX      255     // largest LoRa payload
+#define LINK_QUEUE_SIZE     8
+
+enum class LinkOp : uint8_t {
+    NONE,
+    SEND,       // UI -> radio: data, flag = sense the channel first (ALOHA)
+    CALL,       // UI -> radio: run fn on the radio side, reply if there is a done callback
+    RECEIVED,   // radio -> UI: data, time = RX done timestamp
+    SENT,       // radio -> UI: echoed SEND, status = TX result
+    REPLY,      // radio -> UI: done(status) runs on the UI side
+};
+
+struct LinkFrame {
+    LinkOp op = LinkOp::NONE;
+    bool flag = false;
+    int16_t status = 0;
+    uint32_t time = 0;
+    Delegate<int16_t()> fn;
+    Delegate<void(int16_t)> done;
+    uint8_t len = 0;
+    uint8_t data[LINK_FRAME_MAX];
+
+    void assign(const void* src, size_t n) {
+        len = n < LINK_FRAME_MAX ? n : LINK_FRAME_MAX;
+        memcpy(data, src, len);
+    }
+};
+
+// The only thing the UI and radio sides share. Each ring has exactly one producer
+// and one consumer, so no locks are needed between the cores.
+class CoreLink {
+    RingBuffer<LinkFrame, LINK_QUEUE_SIZE> down;    // UI -> radio
+    RingBuffer<LinkFrame, LINK_QUEUE_SIZE> up;      // radio -> UI
+    std::atomic<uint32_t> lost{0};
+public:
+    // UI side
+    bool toRadio(const LinkFrame& f)    { return down.push(f); }
+    bool fromRadio(LinkFrame& f)        { return up.pop(f); }
+
+    // radio side
+    bool fromUi(LinkFrame& f)           { return down.pop(f); }
+    bool toUi(const LinkFrame& f) {
+        if (up.push(f)) return true;
+        lost.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    [[nodiscard]] uint32_t lostFrames() const { return lost.load(std::memory_order_relaxed); }
+};
@@ -4,10 +4,19 @@
 
 #include "RadioLib.h"
 #include "buffer.h"
+#include "delegate.h"
+#include "channels.h"
+#include "tdma.h"
+
+#define NET_ERR_QUEUE_FULL  (-1000)
+#define NET_QUEUE_SIZE      4
+#define NET_IDLE            0xFFFFFFFF
+
+class BeaconPacket;
 
 class Packet : public Serializable {
 public:
-    using Factory = std::function<Packet*()>;
+    using Factory = Delegate<Packet*()>;
 
 private:
     static inline std::map<uint8_t, Factory> registry{};
@@ -24,42 +33,80 @@ public:
         auto it = registry.find(id);
         return (it != registry.end()) ? it->second() : nullptr;
     }
+
+    static Packet* parse(const uint8_t* data, size_t len) {
+        ReadBuffer buffer = ReadBuffer(data, len);
+        Packet* packet = create(buffer.u8());
+        if (packet) packet->deserialize(buffer);
+        return packet;
+    }
 };
 
 class NetManager {
     PhysicalLayer* radio = nullptr;
     volatile bool* irq_en;
-    std::map<uint8_t, std::vector<std::function<void(Packet&)>>> listeners;
+    volatile uint32_t* irq_time = nullptr; // DIO1 timestamp, written by the ISR
+    // wraps a Delegate<void(T&)>, hence the size
+    using Listener = Delegate<void(Packet&), sizeof(Delegate<void(Packet&)>)>;
+    std::map<uint8_t, std::vector<Listener>> listeners;
+
+    NetMode mode = NetMode::ALOHA;
+    TdmaClock clock;
+    TdmaSchedule schedule;
+    uint8_t fixed_slot = 0;
+    uint32_t hwid = 0;
+
+    uint16_t beacon_seq = 0;
+    uint32_t beacon_done = 0;
+    uint32_t next_beacon = 0;
+    uint32_t last_beacon = 0;
+
+    ChannelPlan plan;
+    float control = 0;
+    float tuned = 0;
+    uint8_t probe = 0;
+
+    std::vector<std::vector<uint8_t>> tx_queue{};
+
+    int16_t transmit(const uint8_t* data, size_t len);
+    void sendBeacon(uint32_t now);
+    void onBeacon(BeaconPacket& beacon, uint32_t at);
+    void retune(uint32_t network, uint32_t guard);
+    void sampleChannel();
 public:
-    void begin(PhysicalLayer* r, volatile bool* en) {
+    void begin(PhysicalLayer* r, volatile bool* en, volatile uint32_t* ts = nullptr) {
         this->radio = r;
         this->irq_en = en;
+        this->irq_time = ts;
     }
 
-    int16_t send(Packet& packet) const {
-        if (!radio || !irq_en) { return RADIOLIB_ERR_NULL_POINTER; }
+    // slot = 0 derives the slot from the hardware id
+    void configure(NetMode m, uint8_t slots, uint8_t slot, uint32_t id, size_t max_frame);
+    // data slots hop over [start; end] while beacons stay on the control frequency; TDMA only
+    void configureHopping(bool enable, float start, float end, float bandwidth_khz, float control_freq, uint32_t seed);
 
-        *irq_en = false;
-        WriteBuffer buffer = WriteBuffer(packet.size()+1);
-        packet.serialize(buffer);
-        int16_t status = radio->transmit(buffer.raw(), buffer.len());
-        *irq_en = true;
-        radio->startReceive();
-        return status;
-    }
+    [[nodiscard]] NetMode netMode() const   { return mode; }
+    [[nodiscard]] bool slotted() const      { return mode != NetMode::ALOHA; }
+    [[nodiscard]] bool synced() const       { return mode == NetMode::TDMA_COORDINATOR || clock.synced(); }
+    [[nodiscard]] const TdmaClock& tdmaClock() const        { return clock; }
+    [[nodiscard]] const TdmaSchedule& tdmaSchedule() const  { return schedule; }
+    [[nodiscard]] const ChannelPlan& channelPlan() const    { return plan; }
+
+    void retune(); // the radio was tuned away (band scan): back to the channel tick() wants
+
+    int16_t send(Packet& packet);
+    int16_t send(const uint8_t* data, size_t len); // immediate in ALOHA mode, queued for the own slot otherwise
+    void tick();
+    [[nodiscard]] uint32_t nextTick() const; // us until tick() has something to do, NET_IDLE if never
 
     template<typename T>
-    void reg(std::function<void(T&)> fn) {
+    void reg(Delegate<void(T&)> fn) {
         uint8_t id = T::PACKET_TYPE;
         listeners[id].push_back([fn](Packet& p) {
             fn(static_cast<T&>(p));
         });
     }
 
-    void dispatch(Packet& p) {
-        auto it = listeners.find(p.type());
-        if (it != listeners.end()) {
-            for (auto& f : it->second) f(p);
-        }
-    }
+    void handle(Packet& p, uint32_t at);   // MAC side (beacons), same thread as tick()/send()
+    void dispatch(Packet& p);               // listeners, may run on another core than the MAC
 };
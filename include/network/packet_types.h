@@ -19,3 +19,44 @@ public:
     void serialize(WriteBuffer& buffer) override;
     void deserialize(ReadBuffer& buffer) override;
 };
+
+// TDMA sync beacon. Two-step: the TX-done time of a beacon is only known after
+// it has been sent, so each beacon carries the one of its predecessor.
+class BeaconPacket : public HelloPacket {
+    uint16_t _seq = 0;
+    uint32_t _frame_start = 0;
+    uint32_t _prev_done = 0;
+    uint8_t _slots = 0;
+    uint32_t _slot_us = 0;
+    uint8_t _channels = 0;      // 0 = no hopping
+    uint32_t _plan = 0;         // ChannelPlan::id()
+    uint32_t _busy = 0;
+public:
+    const static uint8_t PACKET_TYPE = 0x02;
+
+    BeaconPacket() {}
+    ~BeaconPacket() override {}
+
+    uint8_t type() override         { return PACKET_TYPE; };
+    size_t size() override          { return HelloPacket::size() + sizeof(uint16_t) + 5 * sizeof(uint32_t) + 2 * sizeof(uint8_t); };
+
+    uint16_t seq() const            { return _seq; }
+    void seq(uint16_t s)            { _seq = s; }
+    uint32_t frameStart() const     { return _frame_start; }
+    void frameStart(uint32_t t)     { _frame_start = t; }
+    uint32_t prevDone() const       { return _prev_done; }
+    void prevDone(uint32_t t)       { _prev_done = t; }
+    uint8_t slots() const           { return _slots; }
+    void slots(uint8_t n)           { _slots = n; }
+    uint32_t slotUs() const         { return _slot_us; }
+    void slotUs(uint32_t us)        { _slot_us = us; }
+    uint8_t channels() const        { return _channels; }
+    void channels(uint8_t n)        { _channels = n; }
+    uint32_t plan() const           { return _plan; }
+    void plan(uint32_t id)          { _plan = id; }
+    uint32_t busyMask() const       { return _busy; }
+    void busyMask(uint32_t m)       { _busy = m; }
+
+    void serialize(WriteBuffer& buffer) override;
+    void deserialize(ReadBuffer& buffer) override;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+
+// NOTE: no Arduino/RadioLib here on purpose, so the TDMA math can be driven
+// by a host simulation with fake clocks.
+
+#define TDMA_TURNAROUND_US      1000    // RX->TX switch + ISR latency
+#define TDMA_JITTER_US          250     // timestamping jitter of a single beacon
+#define TDMA_FREE_PPM           40      // worst-case crystal error before drift is estimated
+#define TDMA_TRACKED_PPM        5       // residual error once drift is estimated, on top of the estimate's own jitter
+#define TDMA_DRIFT_WINDOW       16      // two-step samples per drift baseline
+#define TDMA_SYNC_LOSS          8       // missed beacons before a node considers itself unsynced
+
+enum class NetMode : uint8_t {
+    ALOHA, TDMA_NODE, TDMA_COORDINATOR
+};
+
+// Local -> network (coordinator) time mapping, all in microseconds.
+// Timestamps are wrapping 32-bit counters (micros()), so only differences are used.
+class TdmaClock {
+    int32_t offset = 0;         // network - local at ref_local
+    float drift = 0;            // d(offset)/d(local)
+    uint32_t ref_local = 0;
+
+    uint32_t prev_rx = 0;       // local RX-done time of the previous beacon
+    uint16_t prev_seq = 0;
+    bool has_prev = false;
+
+    uint8_t samples = 0;        // number of two-step samples taken
+    bool locked = false;
+
+    // drift is the slope over a baseline one to two windows long: between consecutive
+    // beacons the offset changes by a few us of drift and up to 2x the jitter
+    uint32_t base_local = 0, next_local = 0;
+    int32_t base_offset = 0, next_offset = 0;
+    uint8_t window = 0;
+    uint32_t span = 0;          // baseline of the current drift estimate, 0 = none
+
+    static uint32_t estimateError(uint32_t baseline); // ppm
+public:
+    void reset();
+
+    void coarse(uint32_t local_rx, uint32_t remote_done);
+    void precise(uint16_t seq, uint32_t local_rx, uint16_t prev_seq, uint32_t remote_prev_done);
+
+    [[nodiscard]] bool synced() const           { return locked; }
+    [[nodiscard]] bool tracking() const         { return span > 0; }
+    [[nodiscard]] float driftPpm() const        { return drift * 1e6f; }
+    [[nodiscard]] int32_t offsetUs() const      { return offset; }
+
+    [[nodiscard]] uint32_t toNetwork(uint32_t local) const;
+    [[nodiscard]] uint32_t toLocal(uint32_t network) const;
+    [[nodiscard]] uint32_t uncertainty(uint32_t local) const;
+};
+
+
+// Frame layout: slot 0 carries the coordinator's beacon, slots 1..n-1 are data slots.
+class TdmaSchedule {
+    uint8_t slots = 0;
+    uint32_t slot_us = 0;
+    uint32_t frame_start = 0;   // network time of the last known frame start
+    uint16_t frame_seq = 0;     // beacon sequence number of that frame
+    uint8_t own_slot = 0;
+public:
+    static uint32_t guardTime(uint32_t airtime, uint32_t uncertainty);
+    static uint32_t slotLength(uint32_t max_airtime);
+    static uint8_t autoSlot(uint32_t hwid, uint8_t slots);
+
+    void configure(uint8_t n, uint32_t len)     { slots = n; slot_us = len; }
+    void anchor(uint32_t network_start, uint16_t seq = 0)
+                                                { frame_start = network_start; frame_seq = seq; }
+    void assign(uint8_t slot)                   { own_slot = slot; }
+
+    [[nodiscard]] uint8_t slotCount() const     { return slots; }
+    [[nodiscard]] uint32_t slotUs() const       { return slot_us; }
+    [[nodiscard]] uint32_t frameUs() const      { return slots * slot_us; }
+    [[nodiscard]] uint32_t frameStart() const   { return frame_start; }
+    [[nodiscard]] uint8_t ownSlot() const       { return own_slot; }
+    [[nodiscard]] bool valid() const            { return slots > 1 && slot_us > 0; }
+
+    [[nodiscard]] uint32_t position(uint32_t network) const;
+    [[nodiscard]] uint32_t frameIndex(uint32_t network) const;
+    [[nodiscard]] bool inBeaconWindow(uint32_t network, uint32_t guard) const;
+    [[nodiscard]] bool canSend(uint32_t network, uint32_t airtime, uint32_t guard) const;
+    [[nodiscard]] uint32_t untilSlot(uint32_t network, uint32_t guard) const;
+    [[nodiscard]] uint32_t untilWindowEdge(uint32_t network, uint32_t guard) const;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Scoped timing probes, enabled with -D ENABLE_PROBES:
+//
+//     void UIContext::render(UIApp& app) {
+//         PROBE("render");
+//         ...
+//
+// Every PROBE site owns a constant-initialized ProbeSite, so a hit costs two timer
+// reads and a few adds; without the flag the macro compiles to nothing.
+// Ticks are CPU cycles (DWT CYCCNT) on STM32, microseconds on RP2040 and
+// nanoseconds on a host.
+
+#if defined(ENABLE_PROBES) && defined(ARDUINO_ARCH_STM32)
+#include <Arduino.h>
+inline uint32_t probeNow()          { return DWT->CYCCNT; }
+inline uint32_t probeTicksPerUs()   { return SystemCoreClock / 1000000; }
+
+#elif defined(ENABLE_PROBES) && defined(ARDUINO_ARCH_RP2040)
+#include <hardware/timer.h>
+inline uint32_t probeNow()          { return time_us_32(); }
+inline uint32_t probeTicksPerUs()   { return 1; }
+
+#elif defined(ENABLE_PROBES)
+#include <ctime>
+inline uint32_t probeNow() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+inline uint32_t probeTicksPerUs()   { return 1000; }
+#endif
+
+class ProbeSite {
+    static inline std::atomic<ProbeSite*> head{nullptr};
+
+    const char* site_name;
+    ProbeSite* next_site = nullptr;
+    bool linked = false;
+
+    uint32_t hits = 0;
+    uint32_t min_ticks = UINT32_MAX;
+    uint32_t max_ticks = 0;
+    uint64_t total = 0;
+
+    void link();
+public:
+    constexpr explicit ProbeSite(const char* name) : site_name(name) {}
+
+    void record(uint32_t ticks) {
+        if (!linked) link();
+        hits++;
+        total += ticks;
+        if (ticks < min_ticks) min_ticks = ticks;
+        if (ticks > max_ticks) max_ticks = ticks;
+    }
+    void reset();
+
+    [[nodiscard]] const char* name() const  { return site_name; }
+    [[nodiscard]] uint32_t count() const    { return hits; }
+    [[nodiscard]] uint32_t minUs() const;
+    [[nodiscard]] uint32_t avgUs() const;
+    [[nodiscard]] uint32_t maxUs() const;
+
+    // sites register on their first hit, so only the ones that ran are listed
+    static ProbeSite* first()               { return head.load(std::memory_order_acquire); }
+    [[nodiscard]] ProbeSite* next() const   { return next_site; }
+    static void resetAll();
+    size_t format(char* buf, size_t size) const; // "name n avg/min/max us"
+};
+
+#ifdef ENABLE_PROBES
+class Probe {
+    ProbeSite& site;
+    uint32_t start;
+public:
+    explicit Probe(ProbeSite& s) : site(s), start(probeNow()) {}
+    ~Probe() { site.record(probeNow() - start); }
+
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+};
+
+#define PROBE_CONCAT_(a, b) a##b
+#define PROBE_CONCAT(a, b)  PROBE_CONCAT_(a, b)
+#define PROBE(name) \
+    static ProbeSite PROBE_CONCAT(probe_site_, __LINE__){name}; \
+    Probe PROBE_CONCAT(probe_, __LINE__){PROBE_CONCAT(probe_site_, __LINE__)}
+
+void probeBegin(); // starts the cycle counter where there is one
+
+#else
+#define PROBE(name) ((void)0)
+inline void probeBegin() {}
+#endif
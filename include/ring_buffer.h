@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer/single-consumer queue. Safe between an ISR and the main
+// loop (or between two cores) as long as each side only pushes or only pops.
+template<typename T, size_t N>
+class RingBuffer {
+    static_assert(N && (N & (N - 1)) == 0, "N must be a power of two");
+
+    T items[N]{};
+    std::atomic<size_t> head{0}; // next write
+    std::atomic<size_t> tail{0}; // next read
+public:
+    bool push(const T& v) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return false;
+        items[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& v) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        v = items[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] const T* peek() const {
+        size_t t = tail.load(std::memory_order_relaxed);
+        return t == head.load(std::memory_order_acquire) ? nullptr : &items[t & (N - 1)];
+    }
+
+    [[nodiscard]] size_t size() const   { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const    { return size() == 0; }
+    [[nodiscard]] bool full() const     { return size() == N; }
+    [[nodiscard]] static constexpr size_t capacity() { return N; }
+};
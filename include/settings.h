@@ -4,7 +4,7 @@
 #include <EEPROM.h>
 
 #define EEPROM_SIZE     1024
-#define CFG_VERSION     0x04
+#define CFG_VERSION     0x06
 
 struct SettingsData {
     float   radio_frequency =   868.000f;
@@ -15,6 +15,12 @@ struct SettingsData {
     uint8_t radio_preamble =    8;
     uint8_t radio_band =        0;
 
+    uint8_t net_mode =          0; // NetMode
+    uint8_t tdma_slots =        8;
+    uint8_t tdma_slot =         0; // 0 = derived from hwid
+    bool    net_hopping =       false;
+    char    net_key[16] =       "qubix";
+
     uint8_t display_contrast =  50;
     uint8_t display_backlight = 128;
     bool    display_inverted =  false;
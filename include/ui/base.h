@@ -15,13 +15,25 @@ class UIElement {
 public:
     char icon = 0x00;
     String title{};
-    String getLabel(int16_t available = -1) const;
+
+    // icon + title cut to `available` characters with a trailing ellipsis (< 0: no limit);
+    // print* return the number of characters written
+    static int16_t labelLength(char icon, const char* title, int16_t available = -1);
+    static int16_t printLabel(UIContext& ctx, char icon, const char* title, int16_t available = -1);
+    int16_t printLabel(UIContext& ctx, int16_t available = -1) const { return printLabel(ctx, icon, title.c_str(), available); }
+
+    // the label, cut to leave room for `value_length` characters, then the padding that right-aligns them
+    static void printPrefix(UIContext& ctx, char icon, const char* title, uint8_t value_length);
+    void printPrefix(UIContext& ctx, uint8_t value_length) const { printPrefix(ctx, icon, title.c_str(), value_length); }
 
     virtual ~UIElement() = default;
 
     virtual void render(UIContext& ctx, bool minimalized) = 0;
     virtual bool update(UIContext& ctx, char key) { return false; }; // true when character processed; false otherwise
 
+    virtual UIElement* enter() { return this; } // element that takes over when selected in a menu
+    virtual void leave() {}
+
     [[nodiscard]] virtual ElementType getType() const { return ElementType::BASIC; };
 };
 
@@ -58,6 +70,8 @@ public:
 class UIApp {
     UIElement* root;
     std::vector<UIModal*> modals{};
+    bool colorized;
+    Markup markup;  // compiled title when colorized, `title` keeps the plain text
 
     UIModal* eraseFirstModal();
     UIModal* eraseLastModal();
@@ -67,6 +81,7 @@ public:
     struct Config {
         String title = "";
         UIElement* root = nullptr;
+        bool colorized = false;
     };
 
     class Builder {
@@ -74,6 +89,7 @@ public:
     public:
         Builder& title(const String& t) { c_.title = t; return *this; }
         Builder& root(UIElement* root) { c_.root = root; return *this; }
+        Builder& colorized(bool c = true) { c_.colorized = c; return *this; }
 
         [[nodiscard]] UIApp build() const {
             // assert(c_.root != nullptr && "Root cannot be nullptr");
@@ -91,8 +107,16 @@ public:
     static Builder make() { return Builder{}; }
 
     explicit UIApp(const Config& cfg)
-        : root(cfg.root) { title = cfg.title; }
+        : root(cfg.root), colorized(cfg.colorized) {
+        if (colorized) {
+            markup.compile(cfg.title.c_str());
+            title = markup.plain();
+        } else {
+            title = cfg.title;
+        }
+    }
 
+    void setRoot(UIElement* r) { root = r; }
     void addModal(UIModal* modal) { modals.push_back(modal); }
     bool hasModals() const { return !modals.empty(); }
 
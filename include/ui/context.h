@@ -4,9 +4,13 @@
 
 // #include "base.h"
 #include "configuration.h"
+#include "glyph_cache.h"
+#include "markup.h"
 
 class UIApp;
 
+uint16_t rgb565(uint32_t rgb);
+
 struct UITheme {
     uint16_t foreground;
     uint16_t background;
@@ -15,6 +19,25 @@ struct UITheme {
     uint16_t& bg = background;
 };
 
+struct UIRect {
+    int16_t x = 0, y = 0, w = 0, h = 0;
+
+    [[nodiscard]] bool empty() const { return w <= 0 || h <= 0; }
+    void add(int16_t ax, int16_t ay, int16_t aw, int16_t ah);
+};
+
+// What the previous frame printed into one character cell, so the next frame
+// only has to draw the cells that changed.
+struct TextCell {
+    char ch = ' ';
+    bool drawn = false; // printed during the current frame
+#ifdef HAS_COLOR
+    uint16_t fg = 0, bg = 0;
+#else
+    uint8_t ink = 0;    // bit 0: foreground lit, bit 1: background lit
+#endif
+};
+
 #define DISPLAY_MODE_NONE        0
 #define DISPLAY_MODE_BUFFERED    1
 #define DISPLAY_MODE_BUFFERLESS  2
@@ -27,10 +50,32 @@ class UIContext {
     bool refresh_requested = false;
     bool refresh_full = false;
 
-#if DISPLAY_MODE == DISPLAY_MODE_EINK
-    uint8_t partial_updates = 0;
-    const uint8_t partial_cap = 15; // each n-th is full; TODO: move into configuration.h or make config configurable
-#endif
+    bool animation_requested = false;
+    uint32_t animation_delay = 0;
+
+    uint16_t text_fg = 1, text_bg = 0;
+
+    TextCell* cells = nullptr;
+    uint16_t cell_capacity = 0;
+    uint8_t cols = 0, rows = 0;
+    bool cached = false;        // cells describe what is on the screen
+    uint16_t cached_bg = 0;     // background the screen was cleared with
+    bool full_draw = true;      // this frame draws every cell, not just the changed ones
+    bool invalidated = false;   // this frame drew around the cell cache
+    UIRect damaged{};
+    GlyphCache scaled_glyphs;   // text at sizes other than 1
+
+    void clearScreen();
+    void beginFrame();
+    void endFrame();
+    void drawGlyph(int16_t gx, int16_t gy, char c);
+    void writeScaled(char c, int16_t cx, int16_t cy);
+    void write(char c);
+    void write(const char* text) { while (*text) write(*text++); }
+    void printMarkup(const char* text);
+    static bool sameCell(const TextCell& cell, char c, uint16_t fg, uint16_t bg);
+    static void storeCell(TextCell& cell, char c, uint16_t fg, uint16_t bg);
+
 public:
 #ifdef THEME
     UITheme theme = THEME;
@@ -42,8 +87,8 @@ public:
     DisplayType& display;
     int16_t x, y, width, height;
 
-    explicit UIContext(DisplayType& display)
-        : display(display), x(0), y(0), width(display.width()), height(display.height()) {}
+    explicit UIContext(DisplayType& display);
+    ~UIContext() { delete[] cells; }
 
     [[nodiscard]] int16_t charWidth() const         { return glyph_width * text_size + 0.5; }
     [[nodiscard]] int16_t charHeight() const        { return glyph_height * text_size + 0.5; }
@@ -57,6 +102,9 @@ public:
     [[nodiscard]] uint8_t availableSpaces(uint8_t chars) const;
 
     [[nodiscard]] bool refreshRequested() const     { return refresh_requested; }
+    [[nodiscard]] bool animating() const            { return animation_requested; }
+    [[nodiscard]] uint32_t animationDelay() const   { return animation_delay; }
+    [[nodiscard]] const UIRect& damage() const      { return damaged; } // area the last frame changed
 
 
     void sync();
@@ -64,6 +112,10 @@ public:
     void render(UIApp& app);
     void flush();
     void refresh(bool full = false);
+    void animate(uint32_t in_ms = 0); // from render(): draw again in at most in_ms, paced by the frame scheduler
+    void invalidate(); // from render(): this element draws graphics, so the frame can't go through the cell cache
+    void shade(uint16_t color); // from render(): every other pixel of the screen in color, behind modals
+    void scrolled(int16_t rows); // from update(): a list moved up by rows text rows, the panel may scroll what it shows
 
     void setCursor(int16_t tx, int16_t ty);
     void setCharCursor(int16_t cx, int16_t cy);
@@ -77,13 +129,19 @@ public:
     void invertColors();
     void resetColors();
 
-    void print(const String& text, bool colorized = false);
-    void print(const char text, bool colorized = false)                 { print(String(text), colorized); }
+    // none of these allocate; String overloads only read the string
+    void print(const char* text, bool colorized = false);
+    void print(const String& text, bool colorized = false)              { print(text.c_str(), colorized); }
+    void print(char c);
+    void printn(const char* text, size_t length);   // at most `length` characters of text
+
+    void println(const char* text = "", bool colorized = false);
+    void println(const String& text, bool colorized = false)            { println(text.c_str(), colorized); }
+    void println(char c);
 
-    void println(const String& text = String{}, bool colorized = false) { print(text + "\n", colorized); }
-    void println(const char* text, bool colorized = false)              { println(String(text), colorized); }
-    void println(const char text, bool colorized = false)               { println(String(text), colorized); };
+    void print(const Markup& markup);   // precompiled colors, see markup.h
+    void println(const Markup& markup);
 
-    void printf(const char* format, ...);
+    void printf(const char* format, ...);       // formatted on the stack, up to 127 characters
     void printfColor(const char* format, ...);
 };
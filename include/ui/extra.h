@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <RadioLib.h>
 
+#include "alloc_tracker.h"
 #include "base.h"
+#include "boot_log.h"
 #include "inputs.h"
+#include "probe.h"
 
 class CharTable : public UIElement {
     int8_t start = 0;
@@ -26,32 +30,41 @@ public:
 };
 
 
-struct ScanEntry {
-    float freq, rssi;
-};
+#define SCAN_POINTS 128
 
 class BandScanner : public UIElement {
-    // ScanEntry last_scan[2048]{};
-    float last_scan[128];
-    uint16_t scan_channels = 0;
-    uint64_t scan_time = 0;
-    SX1262* radioPtr;
+    struct Scan {
+        float rssi[SCAN_POINTS];
+        float lo = 999, hi = -999;
+    };
 
-    const float start = 863.000;
-    const float end =   870.000;
-    const float step =  (end - start) / 128;
+    // sweep() fills the hidden scan while render() draws the shown one; finish() swaps them
+    Scan scans[2];
+    uint8_t shown = 0;
+    std::atomic<bool> sweeping{false}; // one sweep in flight, so they can't flood the radio queue
+
+    SX1262* radioPtr;
+    Delegate<bool(BandScanner*)> sweeper;
+    Delegate<void()> retune;
 
-    float min_rssi = 999;
-    float max_rssi = -999;
+    const float start = BAND_START;
+    const float end =   BAND_END;
+    const float step =  (end - start) / SCAN_POINTS;
 public:
     struct Config {
         SX1262* radioPtr = nullptr;
+        // queues sweep() wherever the radio lives and finish() back on the UI side, false if it
+        // couldn't; both run inline if unset
+        Delegate<bool(BandScanner*)> sweeper;
+        Delegate<void()> retune; // back to the working channel after a sweep, radio_frequency if unset
     };
 
     class Builder {
         Config c_;
     public:
         Builder& radio(SX1262* r) { c_.radioPtr = r; return *this; }
+        Builder& sweeper(Delegate<bool(BandScanner*)> fn) { c_.sweeper = fn; return *this; }
+        Builder& retune(Delegate<void()> fn) { c_.retune = fn; return *this; }
 
         [[nodiscard]] BandScanner build() const { return BandScanner(c_); }
         [[nodiscard]] BandScanner* buildPtr() const { return new BandScanner(c_); }
@@ -60,18 +73,106 @@ public:
     static Builder make() { return Builder{}; }
 
     explicit BandScanner(const Config& cfg)
-        : radioPtr(cfg.radioPtr) {
+        : radioPtr(cfg.radioPtr), sweeper(cfg.sweeper), retune(cfg.retune) {
         icon = 0x00; title = "Scanner";
-        for (uint16_t i = 0; i < 128; i++) {
-            last_scan[i] = -150.0f;
+        for (Scan& scan : scans) {
+            for (float& rssi : scan.rssi) rssi = -150.0f;
         }
     };
 
+    void sweep();   // radio side
+    void finish();  // UI side, once sweep() has returned
+
+    void render(UIContext& ctx, bool minimalized) override;
+    bool update(UIContext& ctx, char key) override;
+};
+
+
+class ProbeView : public UIElement {
+    int8_t start = 0;
+public:
+    struct Config {};
+
+    class Builder {
+        Config c_;
+    public:
+        [[nodiscard]] ProbeView build() const { return ProbeView(c_); }
+        [[nodiscard]] ProbeView* buildPtr() const { return new ProbeView(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit ProbeView(const Config& cfg) { icon = 0x00; title = "Probes"; };
+
+    void render(UIContext& ctx, bool minimalized) override;
+    bool update(UIContext& ctx, char key) override;
+};
+
+
+class AllocView : public UIElement {
+    int8_t start = 0;
+public:
+    struct Config {};
+
+    class Builder {
+        Config c_;
+    public:
+        [[nodiscard]] AllocView build() const { return AllocView(c_); }
+        [[nodiscard]] AllocView* buildPtr() const { return new AllocView(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit AllocView(const Config& cfg) { icon = 0x00; title = "Allocs"; };
+
     void render(UIContext& ctx, bool minimalized) override;
     bool update(UIContext& ctx, char key) override;
 };
 
 
+class MemoryView : public UIElement {
+public:
+    struct Config {};
+
+    class Builder {
+        Config c_;
+    public:
+        [[nodiscard]] MemoryView build() const { return MemoryView(c_); }
+        [[nodiscard]] MemoryView* buildPtr() const { return new MemoryView(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit MemoryView(const Config& cfg) { icon = 0x00; title = "Memory"; };
+
+    void render(UIContext& ctx, bool minimalized) override;
+};
+
+
+class BootView : public UIElement {
+    const BootLog* log;
+public:
+    struct Config {
+        const BootLog* log = nullptr;
+    };
+
+    class Builder {
+        Config c_;
+    public:
+        Builder& log(const BootLog* l) { c_.log = l; return *this; }
+
+        [[nodiscard]] BootView build() const { return BootView(c_); }
+        [[nodiscard]] BootView* buildPtr() const { return new BootView(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit BootView(const Config& cfg) : log(cfg.log) { icon = 0x00; title = "Boot"; };
+
+    void render(UIContext& ctx, bool minimalized) override;
+};
+
+
 class ColorWheel : public UIElement {
     int8_t start = 0;
 public:
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+// NOTE: plain milliseconds in, no Arduino, so pacing can be checked on a host.
+
+#define FRAME_DUTY              4       // animations may take at most 1/FRAME_DUTY of the time
+#define FRAME_LATENCY_SAMPLES   64      // key-to-pixel samples kept for percentiles
+#define FRAME_NONE              0xFFFFFFFF
+
+// Decides when the next frame is drawn. Input and other refreshes render on the
+// next loop pass, all requests made before that coalesce into one frame. Animations
+// are paced to the display's max rate or FRAME_DUTY times the measured frame cost,
+// whichever is slower.
+class FrameScheduler {
+    uint32_t min_interval;
+    uint32_t frame_cost = 0;        // render + flush, smoothed
+    uint32_t frame_start = 0;
+    uint32_t last_frame = 0;
+
+    bool pending = false;
+    bool animating = false;
+    uint32_t animate_at = 0;
+
+    bool has_input = false;
+    uint32_t input_time = 0;        // oldest key not on screen yet
+    uint32_t frame_input = 0;       // the one the current frame is drawing
+    bool frame_has_input = false;
+
+    uint16_t latency[FRAME_LATENCY_SAMPLES]{};
+    uint8_t latency_count = 0;
+    uint8_t latency_pos = 0;
+public:
+    explicit FrameScheduler(uint16_t max_fps) : min_interval(max_fps ? 1000 / max_fps : 0) {}
+
+    void input(uint32_t key_time);          // a key changed the UI
+    void request()                          { pending = true; }
+    void animate(uint32_t at);              // something on screen changes by itself at `at`
+
+    [[nodiscard]] uint32_t untilFrame(uint32_t now) const; // FRAME_NONE if nothing to draw
+
+    void begin(uint32_t now);
+    void end(uint32_t now);
+
+    [[nodiscard]] uint32_t frameCost() const            { return frame_cost; }
+    [[nodiscard]] uint32_t animationInterval() const;
+    [[nodiscard]] uint8_t latencySamples() const        { return latency_count; }
+    [[nodiscard]] uint16_t latencyPercentile(uint8_t p) const; // ms
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// per target through build_flags; 0 bytes turns the cache off (drawChar() fallback)
+#ifndef GLYPH_CACHE_BYTES
+#define GLYPH_CACHE_BYTES 2048  // bitmap pool; a size 8 glyph takes 384 bytes, a size 2 one 32
+#endif
+#ifndef GLYPH_CACHE_SLOTS
+#define GLYPH_CACHE_SLOTS 64
+#endif
+
+// Glyphs of the built-in font rasterized once at a scaled cell size, so text at sizes
+// other than 1 is a drawBitmap() per character instead of a fillRect() per font pixel.
+// Whole-number scales repeat pixels like drawChar() does; fractional ones are area
+// sampled (a pixel is lit when at least half of what it covers is) so strokes stay even.
+// The least recently used glyphs make room when the pool or the slots run out.
+// Nothing is allocated until the first scaled glyph, so size 1 only UIs don't pay for it.
+class GlyphCache {
+    struct Slot {
+        uint32_t used_at;
+        uint16_t offset;
+        uint8_t c, w, h;
+    };
+
+    uint8_t* pool = nullptr;
+    Slot* slots = nullptr;
+    uint8_t count = 0;  // slots are packed into the pool in order
+    uint16_t end = 0;   // bytes of the pool in use
+    uint32_t clock = 0;
+
+    static uint16_t bytes(uint8_t w, uint8_t h) { return (w + 7) / 8 * h; }
+    static void rasterize(uint8_t c, uint8_t w, uint8_t h, uint8_t* out);
+    void evict(uint8_t i);
+
+public:
+    GlyphCache() = default;
+    ~GlyphCache() { delete[] pool; delete[] slots; }
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    // drawBitmap() layout: rows of (w + 7) / 8 bytes, MSB first. Not const so Adafruit_GFX
+    // picks its RAM overload. nullptr when the glyph is larger than the whole pool
+    uint8_t* get(uint8_t c, uint8_t w, uint8_t h);
+    void clear() { count = 0; end = 0; }
+};
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <functional>
-
 #include "base.h"
+#include "delegate.h"
 #include "utils.h"
 
 template<class T>
@@ -140,12 +139,12 @@ public:
 
 class Button : public UIClickable {
     bool* ptr;
-    std::function<void()> on_click;
+    Delegate<void()> on_click;
 public:
     struct Config {
         char icon = 0x00;
         String title = "";
-        std::function<void()> on_click = []{};
+        Delegate<void()> on_click = []{};
     };
 
     class Builder {
@@ -153,7 +152,7 @@ public:
     public:
         Builder& icon(char i) { c_.icon = i; return *this; }
         Builder& title(const String& t) { c_.title = t; return *this; }
-        Builder& onClick(std::function<void()> f) { c_.on_click = std::move(f); return *this; }
+        Builder& onClick(Delegate<void()> f) { c_.on_click = f; return *this; }
 
         [[nodiscard]] Button build() const { return Button(c_); }
         [[nodiscard]] Button* buildPtr() const { return new Button(c_); }
@@ -175,7 +174,7 @@ class TextField : public UIInline {
     uint8_t max_length;
     int16_t window_size;
     uint8_t slice_at = 0;
-    std::function<void(char*)> on_submit;
+    Delegate<void(char*)> on_submit;
     bool submittable;
     bool owns_mem = false;
 public:
@@ -186,7 +185,7 @@ public:
         char* ptr = nullptr;
         uint8_t max_length = 64;
         int16_t window_size = -1;
-        std::function<void(char*)> on_submit = [](char*) {};
+        Delegate<void(char*)> on_submit = [](char*) {};
         bool submittable = false;
     };
 
@@ -199,7 +198,7 @@ public:
         Builder& pointer(char c[]) { c_.ptr = c; return *this; }
         Builder& maxLength(uint8_t l) { c_.max_length = l; return *this; }
         Builder& windowSize(int16_t s) { c_.window_size = s; return *this; };
-        Builder& onSubmit(std::function<void(char*)> f) { c_.on_submit = std::move(f); c_.submittable = true; return *this; }
+        Builder& onSubmit(Delegate<void(char*)> f) { c_.on_submit = f; c_.submittable = true; return *this; }
 
         [[nodiscard]] TextField build() const { return TextField(c_); }
         [[nodiscard]] TextField* buildPtr() const { return new TextField(c_); }
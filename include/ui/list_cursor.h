@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "context.h"
+
+// Cursor and scroll window over a list of rows, shared by the menu views.
+// Up and down wrap around at the ends, and the window follows the cursor one row early.
+class ListCursor {
+protected:
+    int16_t slice_at = 0;
+    int16_t cursor = 0;
+    int16_t window_size = -1;   // rows on screen, set by render()
+
+    void clampCursor(int16_t n); // the list may have shrunk
+    bool moveCursor(UIContext& ctx, char key, int16_t n); // KEY_UP/KEY_DOWN, false for other keys
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "delegate.h"
+
+#define MARKUP_STACK 8 // nested [#rrggbb] colors remembered for []
+
+// Color markup used by UIContext::print(text, true):
+//   [#rrggbb]  push a color (1-6 hex digits)     []   pop back to the previous one
+//   [#]        back to the theme foreground      [[   a literal '['
+// Anything else starting with '[' is printed as is.
+
+struct MarkupSpan {
+    uint16_t offset;    // into Markup::plain()
+    uint16_t length;
+    uint16_t color;
+    bool themed;        // theme foreground, resolved when drawn so theme changes apply
+};
+
+// A string compiled once into its plain text and the color runs over it, so drawing it
+// is a walk over spans instead of parsing the markup again every frame.
+class Markup {
+    char* text = nullptr;
+    MarkupSpan* spans = nullptr;
+    uint16_t length = 0;
+    uint16_t count = 0;
+
+public:
+    using TextSink = Delegate<void(char c)>;
+    using ColorSink = Delegate<void(uint16_t color, bool themed)>;
+
+    // streams the markup without building anything, for one-off strings
+    static void parse(const char* source, TextSink text, ColorSink color);
+
+    Markup() = default;
+    explicit Markup(const char* source) { compile(source); }
+    Markup(const Markup& other);
+    Markup& operator=(const Markup& other);
+    ~Markup();
+
+    void compile(const char* source);
+
+    [[nodiscard]] const char* plain() const             { return text ? text : ""; }
+    [[nodiscard]] uint16_t plainLength() const          { return length; }
+    [[nodiscard]] uint16_t spanCount() const            { return count; }
+    [[nodiscard]] const MarkupSpan& span(uint16_t i) const { return spans[i]; }
+};
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <functional>
-
 #include "base.h"
+#include "delegate.h"
 
 class Alert : public UIModal {
 public:
@@ -32,11 +31,11 @@ public:
 
 class ConfirmModal : public UIModal {
     bool flag = false;
-    std::function<void()> on_confirm = [] {};
+    Delegate<void()> on_confirm = [] {};
 public:
     struct Config {
         String message = "";
-        std::function<void()> on_confirm = [] {};
+        Delegate<void()> on_confirm = [] {};
 
     };
 
@@ -44,7 +43,7 @@ public:
         Config c_;
     public:
         Builder& message(const String& m) { c_.message = m; return *this; }
-        Builder& onConfirm(std::function<void()> f) { c_.on_confirm = std::move(f); return *this; }
+        Builder& onConfirm(Delegate<void()> f) { c_.on_confirm = f; return *this; }
 
         [[nodiscard]] ConfirmModal build() const { return ConfirmModal(c_); };
         [[nodiscard]] ConfirmModal* buildPtr() const { return new ConfirmModal(c_); };
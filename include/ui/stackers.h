@@ -1,23 +1,39 @@
 #pragma once
 
-#include <functional>
-
 #include "base.h"
+#include "delegate.h"
+#include "list_cursor.h"
 
 enum class FillMode {
     NONE, BOTTOM, TOP
 };
 
-class MenuView : public UIActive {
+enum class SubtreePolicy {
+    KEEP, RELEASE
+};
+
+// Either a list of child elements, or a virtual list: a row count plus callbacks that
+// draw row i and open it. Virtual rows cost nothing until they are on screen, and only
+// an opened row gets a heap object (freed again on exit).
+class MenuView : public UIActive, ListCursor {
     UIElement* selected = nullptr;
     std::vector<UIElement*> children;
     FillMode fill_mode;
+    bool colorized;
+    Markup markup;  // compiled title when colorized, `title` keeps the plain text
+
+    Delegate<void()> on_exit;
 
-    int16_t slice_at = 0;
-    int16_t cursor = 0;
-    int16_t window_size;
+    Delegate<uint16_t()> row_count;
+    Delegate<void(UIContext&, uint16_t)> render_row;    // one line, ends with println()
+    Delegate<UIElement*(uint16_t)> open_row;            // nullptr when activating needs no element
+    UIElement* opened = nullptr;                        // owned, virtual rows only
 
-    std::function<void()> on_exit;
+    [[nodiscard]] bool isVirtual() const { return static_cast<bool>(row_count); }
+    [[nodiscard]] int16_t size() const { return isVirtual() ? row_count() : children.size(); }
+    void renderRow(UIContext& ctx, int16_t i);
+    bool activate(UIContext& ctx);
+    void leaveSelected();
 
 public:
     struct Config {
@@ -25,8 +41,12 @@ public:
         String title = "";
         std::vector<UIElement*> children{};
         FillMode fill_mode = FillMode::NONE;
+        bool colorized = false;
         int16_t window_size = -1;
-        std::function<void()> on_exit = [] {};
+        Delegate<void()> on_exit = [] {};
+        Delegate<uint16_t()> row_count = nullptr;
+        Delegate<void(UIContext&, uint16_t)> render_row = nullptr;
+        Delegate<UIElement*(uint16_t)> open_row = nullptr;
     };
 
     class Builder {
@@ -38,10 +58,14 @@ public:
         Builder& children(const std::initializer_list<UIElement*>& v) { c_.children = v; return *this; }
         Builder& addChild(UIElement* e) { c_.children.push_back(e); return *this; }
         Builder& fill(FillMode m) { c_.fill_mode = m; return *this; }
+        Builder& colorized(bool c = true) { c_.colorized = c; return *this; }
         Builder& windowSize(uint8_t s) { c_.window_size = s; return *this; }
-        Builder& onExit(std::function<void()> f) { c_.on_exit = std::move(f); return *this; }
+        Builder& onExit(Delegate<void()> f) { c_.on_exit = f; return *this; }
+        Builder& rows(Delegate<uint16_t()> count, Delegate<void(UIContext&, uint16_t)> render) {
+            c_.row_count = count; c_.render_row = render; return *this;
+        }
+        Builder& onOpen(Delegate<UIElement*(uint16_t)> f) { c_.open_row = f; return *this; }
 
-        [[nodiscard]] MenuView build() const { return MenuView(c_); }
         [[nodiscard]] MenuView* buildPtr() const { return new MenuView(c_); }
     };
 
@@ -50,10 +74,27 @@ public:
     explicit MenuView(const Config& cfg)
         : children(cfg.children),
           fill_mode(cfg.fill_mode),
-          window_size(cfg.window_size),
-          on_exit(cfg.on_exit) { icon = cfg.icon; title = cfg.title; }
+          colorized(cfg.colorized),
+          on_exit(cfg.on_exit),
+          row_count(cfg.row_count),
+          render_row(cfg.render_row),
+          open_row(cfg.open_row) {
+        icon = cfg.icon;
+        window_size = cfg.window_size;
+        if (colorized) {
+            markup.compile(cfg.title.c_str());
+            title = markup.plain();
+        } else {
+            title = cfg.title;
+        }
+    }
+
+    ~MenuView() override { for (auto e : children) delete e; delete opened; };
+    MenuView(const MenuView&) = delete;
+    MenuView& operator=(const MenuView&) = delete;
 
     void addChild(UIElement* e);
+    void scrollToEnd(); // cursor on the last row, e.g. after a virtual list grew
     // void removeLastChild() { children.pop_back(); }
     // void removeFirstChild() { children.erase(children.begin()); }
 
@@ -61,6 +102,50 @@ public:
     bool update(UIContext& ctx, char key) override;
 };
 
+// Placeholder for a subtree that is only built once it is entered from a menu.
+// RELEASE frees the subtree again on exit, KEEP holds on to it after the first build.
+class LazyView : public UIElement {
+    Delegate<UIElement*()> factory;
+    SubtreePolicy policy;
+    UIElement* built = nullptr;
+public:
+    struct Config {
+        char icon = 0x00;
+        String title = "";
+        Delegate<UIElement*()> factory = nullptr;
+        SubtreePolicy policy = SubtreePolicy::RELEASE;
+    };
+
+    class Builder {
+        Config c_;
+    public:
+        Builder& icon(char i) { c_.icon = i; return *this; }
+        Builder& title(const String& t) { c_.title = t; return *this; }
+        Builder& factory(Delegate<UIElement*()> f) { c_.factory = f; return *this; }
+        Builder& policy(SubtreePolicy p) { c_.policy = p; return *this; }
+        Builder& keep() { c_.policy = SubtreePolicy::KEEP; return *this; }
+
+        [[nodiscard]] LazyView* buildPtr() const { return new LazyView(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit LazyView(const Config& cfg)
+        : factory(cfg.factory),
+          policy(cfg.policy) { icon = cfg.icon; title = cfg.title; }
+
+    ~LazyView() override { delete built; };
+    LazyView(const LazyView&) = delete;
+    LazyView& operator=(const LazyView&) = delete;
+
+    [[nodiscard]] bool isBuilt() const { return built != nullptr; }
+
+    UIElement* enter() override;
+    void leave() override;
+
+    void render(UIContext& ctx, bool minimalized) override;
+};
+
 class TabSelector : public UIElement {
     std::vector<UIElement*> children;
     uint8_t cursor = 0;
@@ -80,7 +165,6 @@ public:
         Builder& children(const std::initializer_list<UIElement*>& v) { c_.children = v; return *this; }
         Builder& addChild(UIElement* e) { c_.children.push_back(e); return *this; }
 
-        [[nodiscard]] TabSelector build() const { return TabSelector(c_); }
         [[nodiscard]] TabSelector* buildPtr() const { return new TabSelector(c_); }
     };
 
@@ -89,6 +173,10 @@ public:
     explicit TabSelector(const Config& cfg)
         : children(cfg.children) { icon = cfg.icon; title = cfg.title; }
 
+    ~TabSelector() override { for (auto e : children) delete e; };
+    TabSelector(const TabSelector&) = delete;
+    TabSelector& operator=(const TabSelector&) = delete;
+
     void render(UIContext& ctx, bool minimalized) override;
     bool update(UIContext& ctx, char key) override;
 };
@@ -4,11 +4,14 @@
 
 class Label : public UIElement {
     int16_t max_length;
+    bool colorized;
+    Markup markup;  // compiled title when colorized, `title` keeps the plain text
 public:
     struct Config {
         char icon = 0x00;
         String title = "";
         int16_t max_length = -1;
+        bool colorized = false;
     };
 
     class Builder {
@@ -17,6 +20,7 @@ public:
         Builder& icon(char i) { c_.icon = i; return *this; }
         Builder& title(const String& t) { c_.title = t; return *this; }
         Builder& maxLength(uint8_t l) { c_.max_length = l; return *this; }
+        Builder& colorized(bool c = true) { c_.colorized = c; return *this; }
 
         [[nodiscard]] Label build() const { return Label(c_); }
         [[nodiscard]] Label* buildPtr() const { return new Label(c_); }
@@ -25,7 +29,15 @@ public:
     static Builder make() { return Builder{}; }
 
     explicit Label(const Config& cfg)
-        : max_length(cfg.max_length) { icon = cfg.icon; title = cfg.title; }
+        : max_length(cfg.max_length), colorized(cfg.colorized) {
+        icon = cfg.icon;
+        if (colorized) {
+            markup.compile(cfg.title.c_str());
+            title = markup.plain();
+        } else {
+            title = cfg.title;
+        }
+    }
 
     void render(UIContext& ctx, bool minimalized) override;
 };
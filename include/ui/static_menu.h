@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "base.h"
+#include "list_cursor.h"
+
+enum class EntryKind : uint8_t {
+    LABEL, SUBMENU, TOGGLE, NUMBER, SELECT, TEXT, VALUE, ACTION, ELEMENT
+};
+
+enum class ValueType : uint8_t {
+    NONE, U8, I8, FLOAT, BOOL, STR
+};
+
+struct MenuTable;
+
+// One row of a menu that is fixed at compile time. Tables of these are constexpr,
+// so they stay in flash; everything they point to must have static storage.
+struct MenuEntry {
+    EntryKind kind = EntryKind::LABEL;
+    ValueType type = ValueType::NONE;
+    char icon = 0x00;
+    const char* title = "";
+    void* ptr = nullptr;                    // bound value
+    float min = 0;
+    float max = 0;
+    uint8_t precision = 0;
+    int8_t cursor = 0;
+    uint8_t length = 0;                     // TEXT max length, SELECT/VALUE name count
+    const char* text = "";                  // NUMBER suffix, VALUE format
+    const char* const* names = nullptr;     // SELECT items, VALUE names
+    const MenuTable* submenu = nullptr;
+    void (*action)() = nullptr;
+    void (*getter)(char* buf, size_t len) = nullptr;
+    UIElement* (*factory)() = nullptr;
+
+    static constexpr MenuEntry label(const char* t) {
+        MenuEntry e;
+        e.title = t;
+        return e;
+    }
+
+    static constexpr MenuEntry menu(const MenuTable& m);
+
+    static constexpr MenuEntry toggle(char i, const char* t, bool* p) {
+        MenuEntry e = make(EntryKind::TOGGLE, i, t);
+        e.type = ValueType::BOOL;
+        e.ptr = p;
+        return e;
+    }
+
+    static constexpr MenuEntry number(char i, const char* t, uint8_t* p, uint8_t min, uint8_t max, const char* suffix = "") {
+        MenuEntry e = make(EntryKind::NUMBER, i, t);
+        e.type = ValueType::U8;
+        e.ptr = p; e.min = min; e.max = max; e.text = suffix;
+        return e;
+    }
+
+    static constexpr MenuEntry number(char i, const char* t, int8_t* p, int8_t min, int8_t max, const char* suffix = "") {
+        MenuEntry e = make(EntryKind::NUMBER, i, t);
+        e.type = ValueType::I8;
+        e.ptr = p; e.min = min; e.max = max; e.text = suffix;
+        return e;
+    }
+
+    static constexpr MenuEntry number(char i, const char* t, float* p, float min, float max,
+                                      uint8_t precision, int8_t cursor = 0, const char* suffix = "") {
+        MenuEntry e = make(EntryKind::NUMBER, i, t);
+        e.type = ValueType::FLOAT;
+        e.ptr = p; e.min = min; e.max = max; e.text = suffix;
+        e.precision = precision; e.cursor = cursor;
+        return e;
+    }
+
+    template<size_t N>
+    static constexpr MenuEntry select(char i, const char* t, uint8_t* p, const char* const (&items)[N]) {
+        MenuEntry e = make(EntryKind::SELECT, i, t);
+        e.type = ValueType::U8;
+        e.ptr = p; e.names = items; e.length = N;
+        return e;
+    }
+
+    static constexpr MenuEntry textField(char i, const char* t, char* p, uint8_t max_length) {
+        MenuEntry e = make(EntryKind::TEXT, i, t);
+        e.type = ValueType::STR;
+        e.ptr = p; e.length = max_length;
+        return e;
+    }
+
+    template<class T>
+    static constexpr MenuEntry value(const char* t, T* p, const char* fmt) {
+        MenuEntry e = make(EntryKind::VALUE, 0x00, t);
+        e.type = typeOf<T>();
+        e.ptr = p; e.text = fmt;
+        return e;
+    }
+
+    template<size_t N>
+    static constexpr MenuEntry value(const char* t, uint8_t* p, const char* const (&names)[N]) {
+        MenuEntry e = make(EntryKind::VALUE, 0x00, t);
+        e.type = ValueType::U8;
+        e.ptr = p; e.names = names; e.length = N;
+        return e;
+    }
+
+    static constexpr MenuEntry value(const char* t, void (*getter)(char*, size_t)) {
+        MenuEntry e = make(EntryKind::VALUE, 0x00, t);
+        e.getter = getter;
+        return e;
+    }
+
+    static constexpr MenuEntry button(char i, const char* t, void (*fn)()) {
+        MenuEntry e = make(EntryKind::ACTION, i, t);
+        e.action = fn;
+        return e;
+    }
+
+    // escape hatch for widgets with state of their own, built when opened and freed on exit
+    static constexpr MenuEntry element(char i, const char* t, UIElement* (*fn)()) {
+        MenuEntry e = make(EntryKind::ELEMENT, i, t);
+        e.factory = fn;
+        return e;
+    }
+
+private:
+    static constexpr MenuEntry make(EntryKind k, char i, const char* t) {
+        MenuEntry e;
+        e.kind = k; e.icon = i; e.title = t;
+        return e;
+    }
+
+    template<class T>
+    static constexpr ValueType typeOf() {
+        if constexpr (std::is_same_v<T, uint8_t>)   return ValueType::U8;
+        if constexpr (std::is_same_v<T, int8_t>)    return ValueType::I8;
+        if constexpr (std::is_same_v<T, float>)     return ValueType::FLOAT;
+        if constexpr (std::is_same_v<T, bool>)      return ValueType::BOOL;
+        if constexpr (std::is_same_v<T, char>)      return ValueType::STR;
+        return ValueType::NONE;
+    }
+};
+
+struct MenuTable {
+    char icon = 0x00;
+    const char* title = "";
+    const MenuEntry* entries = nullptr;
+    uint8_t count = 0;
+    void (*on_exit)() = nullptr;
+
+    template<size_t N>
+    static constexpr MenuTable of(char i, const char* t, const MenuEntry (&e)[N], void (*on_exit)() = nullptr) {
+        return MenuTable{i, t, e, N, on_exit};
+    }
+};
+
+constexpr MenuEntry MenuEntry::menu(const MenuTable& m) {
+    MenuEntry e = make(EntryKind::SUBMENU, m.icon, m.title);
+    e.submenu = &m;
+    return e;
+}
+
+
+// Interpreter for a MenuTable. Rows are drawn straight from the table; only the
+// entry being edited (or an opened submenu/element) gets a heap object.
+class StaticMenu : public UIActive, ListCursor {
+    const MenuTable* table;
+    UIElement* opened = nullptr;    // owned
+    UIElement* selected = nullptr;  // what opened->enter() handed over
+
+    static UIElement* open(const MenuEntry& e);
+    static void formatValue(const MenuEntry& e, char* buf, size_t len);
+    void renderEntry(UIContext& ctx, const MenuEntry& e);
+    void close();
+
+public:
+    struct Config {
+        const MenuTable* table = nullptr;
+    };
+
+    class Builder {
+        Config c_;
+    public:
+        Builder& table(const MenuTable& t) { c_.table = &t; return *this; }
+
+        [[nodiscard]] StaticMenu* buildPtr() const { return new StaticMenu(c_); }
+    };
+
+    static Builder make() { return Builder{}; }
+
+    explicit StaticMenu(const Config& cfg)
+        : table(cfg.table) { icon = table->icon; } // title stays empty, the table has it
+
+    ~StaticMenu() override { delete opened; };
+    StaticMenu(const StaticMenu&) = delete;
+    StaticMenu& operator=(const StaticMenu&) = delete;
+
+    void render(UIContext& ctx, bool minimalized) override;
+    bool update(UIContext& ctx, char key) override;
+};
@@ -22,4 +22,6 @@ uint16_t crc16(const uint8_t* p, size_t n);
 uint32_t crc32(const uint8_t* p, size_t n);
 uint64_t crc64(const uint8_t* p, size_t n);
 int64_t pow10i(uint8_t n);
+inline char hexDigit(uint8_t v) { return "0123456789ABCDEF"[v & 0x0F]; }
+size_t prettyValue(char* buf, size_t len, uint64_t value, const char* symbol, uint8_t precision = 0, uint16_t per_kilo = 1000);
 String prettyValue(uint64_t value, const String& symbol, uint8_t precision = 0, uint16_t per_kilo = 1000);
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "alloc_tracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <Arduino.h>
+#define ALLOC_CORES 2
+static uint8_t allocCore() { return get_core_num(); }
+#else
+#define ALLOC_CORES 1
+static uint8_t allocCore() { return 0; }
+#endif
+
+// On arduino-pico the hooks run under the core's malloc mutex, so plain counters are enough
+static AllocStats tags[static_cast<uint8_t>(AllocTag::COUNT)];
+static AllocSite sites[ALLOC_SITES];
+static uint32_t live = 0;
+static uint32_t peak = 0;
+static AllocTracker::OverBudget over_budget;
+
+static AllocTag current[ALLOC_CORES]{};
+static uint32_t scope_max[ALLOC_CORES]{};           // highest live bytes seen in the open scope
+static const void* pending_site[ALLOC_CORES]{};     // set by operator new, taken by the hook
+
+static AllocStats& statsOf(AllocTag tag) { return tags[static_cast<uint8_t>(tag)]; }
+
+static void noteSite(uintptr_t addr, size_t size) {
+    AllocSite* slot = &sites[0];
+    for (auto& s : sites) {
+        if (s.addr == addr) {
+            slot = &s;
+            break;
+        }
+        if (s.count < slot->count) slot = &s; // evict the least frequent, keep its count as the error bound
+    }
+    slot->addr = addr;
+    slot->count++;
+    slot->bytes += size;
+}
+
+
+/**********************/
+/**** AllocTracker ****/
+/**********************/
+void AllocTracker::record(size_t size, const void* site) {
+    uint8_t core = allocCore();
+    if (pending_site[core]) {
+        site = pending_site[core];
+        pending_site[core] = nullptr;
+    }
+
+    AllocStats& s = statsOf(current[core]);
+    s.allocs++;
+    s.bytes += size;
+
+    live += size;
+    peak = std::max(peak, live);
+    scope_max[core] = std::max(scope_max[core], live);
+    noteSite(reinterpret_cast<uintptr_t>(site), size);
+}
+
+void AllocTracker::release(size_t size) {
+    statsOf(current[allocCore()]).frees++;
+    live -= std::min<uint32_t>(live, size);
+}
+
+void AllocTracker::budget(AllocTag tag, uint32_t allocs) {
+    statsOf(tag).budget = allocs;
+}
+
+void AllocTracker::onOverBudget(OverBudget fn) {
+    over_budget = fn;
+}
+
+void AllocTracker::reset() {
+    for (auto& s : tags) {
+        uint32_t b = s.budget;
+        s = AllocStats{};
+        s.budget = b;
+    }
+    for (auto& s : sites) s = AllocSite{};
+    peak = live;
+}
+
+const AllocStats& AllocTracker::stats(AllocTag tag) { return statsOf(tag); }
+uint32_t AllocTracker::liveBytes()                  { return live; }
+uint32_t AllocTracker::peakBytes()                  { return peak; }
+
+uint8_t AllocTracker::topSites(AllocSite* out, uint8_t n) {
+    AllocSite sorted[ALLOC_SITES];
+    std::copy(sites, sites + ALLOC_SITES, sorted);
+    std::sort(sorted, sorted + ALLOC_SITES, [](const AllocSite& a, const AllocSite& b) { return a.count > b.count; });
+
+    uint8_t used = 0;
+    while (used < n && used < ALLOC_SITES && sorted[used].count) {
+        out[used] = sorted[used];
+        used++;
+    }
+    return used;
+}
+
+const char* AllocTracker::tagName(AllocTag tag) {
+    static const char* names[] = {"other", "render", "keys", "rx", "tx"};
+    return names[static_cast<uint8_t>(tag)];
+}
+
+
+/********************/
+/**** AllocScope ****/
+/********************/
+AllocScope::AllocScope(AllocTag tag) {
+    uint8_t core = allocCore();
+    prev_tag = current[core];
+    prev_max = scope_max[core];
+    current[core] = tag;
+    scope_max[core] = live;
+    live_at = live;
+
+    AllocStats& s = statsOf(tag);
+    allocs_at = s.allocs;
+    s.scopes++;
+}
+
+AllocScope::~AllocScope() {
+    uint8_t core = allocCore();
+    AllocTag tag = current[core];
+    AllocStats& s = statsOf(tag);
+
+    uint32_t allocs = s.allocs - allocs_at;
+    s.worst = std::max(s.worst, allocs);
+    s.peak = std::max(s.peak, scope_max[core] - live_at);
+    if (s.budget && allocs > s.budget) {
+        s.overruns++;
+        if (over_budget) over_budget(tag, allocs);
+    }
+
+    current[core] = prev_tag;
+    scope_max[core] = std::max(prev_max, scope_max[core]);
+}
+
+
+/***************/
+/**** Hooks ****/
+/***************/
+#ifdef ENABLE_ALLOC_TRACKING
+#if defined(ARDUINO)
+#include <reent.h>
+
+// newlib routes malloc/realloc/calloc through these; a realloc that grows in place isn't seen
+extern "C" {
+void* __real__malloc_r(struct _reent* r, size_t n);
+void __real__free_r(struct _reent* r, void* p);
+size_t _malloc_usable_size_r(struct _reent* r, void* p);
+
+void* __wrap__malloc_r(struct _reent* r, size_t n) {
+    void* p = __real__malloc_r(r, n);
+    if (p) AllocTracker::record(_malloc_usable_size_r(r, p), __builtin_return_address(0));
+    return p;
+}
+
+void __wrap__free_r(struct _reent* r, void* p) {
+    if (p) AllocTracker::release(_malloc_usable_size_r(r, p));
+    __real__free_r(r, p);
+}
+}
+
+#else
+#include <malloc.h>
+
+extern "C" {
+void* __real_malloc(size_t n);
+void __real_free(void* p);
+void* __real_realloc(void* p, size_t n);
+void* __real_calloc(size_t n, size_t size);
+
+void* __wrap_malloc(size_t n) {
+    void* p = __real_malloc(n);
+    if (p) AllocTracker::record(malloc_usable_size(p), __builtin_return_address(0));
+    return p;
+}
+
+void __wrap_free(void* p) {
+    if (p) AllocTracker::release(malloc_usable_size(p));
+    __real_free(p);
+}
+
+void* __wrap_realloc(void* p, size_t n) {
+    size_t old = p ? malloc_usable_size(p) : 0;
+    void* q = __real_realloc(p, n);
+    if (!q && n) return q; // failed, p is untouched
+    if (p) AllocTracker::release(old);
+    if (q) AllocTracker::record(malloc_usable_size(q), __builtin_return_address(0));
+    return q;
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    void* p = __real_calloc(n, size);
+    if (p) AllocTracker::record(malloc_usable_size(p), __builtin_return_address(0));
+    return p;
+}
+}
+#endif
+
+// replaced so the call site is the code doing `new`, not the allocator
+void* operator new(size_t n) {
+    pending_site[allocCore()] = __builtin_return_address(0);
+    return malloc(n);
+}
+
+void* operator new[](size_t n) {
+    pending_site[allocCore()] = __builtin_return_address(0);
+    return malloc(n);
+}
+
+void operator delete(void* p) noexcept              { free(p); }
+void operator delete[](void* p) noexcept            { free(p); }
+void operator delete(void* p, size_t) noexcept      { free(p); }
+void operator delete[](void* p, size_t) noexcept    { free(p); }
+#endif
@@ -0,0 +1,45 @@
+#include "cores.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <Arduino.h>
+
+void startRadioCore(void (*)(), void (*)()) {} // arduino-pico starts setup1()/loop1() by itself
+void stopRadioCore() {}
+void wakeCores() { __sev(); } // both cores idle in WFE
+
+#elif !defined(ARDUINO)
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+
+static void (*core_setup)() = nullptr;
+static void (*core_loop)() = nullptr;
+static std::atomic<bool> core_running{false};
+static pthread_t core_thread;
+
+static void* runCore(void*) {
+    core_setup();
+    while (core_running.load(std::memory_order_acquire)) core_loop();
+    return nullptr;
+}
+
+void startRadioCore(void (*setup)(), void (*loop)()) {
+    if (core_running.exchange(true)) return;
+    core_setup = setup;
+    core_loop = loop;
+    pthread_create(&core_thread, nullptr, runCore, nullptr);
+}
+
+void stopRadioCore() {
+    if (!core_running.exchange(false)) return;
+    pthread_join(core_thread, nullptr);
+}
+
+void wakeCores() { sched_yield(); }
+
+#else
+// single-core targets run the radio side from loop()
+void startRadioCore(void (*)(), void (*)()) {}
+void stopRadioCore() {}
+void wakeCores() {}
+#endif
@@ -0,0 +1,54 @@
+#include "displays/display_sh1106.h"
+#ifdef TARGET_SH1106
+
+void Partial_SH1106G::display() {
+    int16_t dy = rotation == 2 ? -scroll_hint : scroll_hint;
+    scroll_hint = 0;
+
+    if (i2c_dev == nullptr) { // SPI wiring isn't used by any board yet
+        Adafruit_SH1106G::display();
+        return;
+    }
+
+    i2c_dev->setSpeed(i2c_preclk);
+    // the start line wraps at the 64 RAM rows, so only a 64 row panel scrolls like the flusher's pages
+    if (!(rotation & 1) && HEIGHT == 64 && dy % 8 == 0 && flusher.scroll(buffer, dy / 8)) {
+        oled_command(SH110X_SETSTARTLINE | flusher.startPage() * 8);
+    }
+    flusher.flush(buffer, [this](uint8_t page, uint8_t col, const uint8_t* data, uint8_t len) {
+        col += SH1106_COLUMN_OFFSET;
+        const uint8_t cmd[] = {
+            static_cast<uint8_t>(SH110X_SETPAGEADDR + page),
+            static_cast<uint8_t>(SH110X_SETHIGHCOLUMN + (col >> 4)),
+            static_cast<uint8_t>(SH110X_SETLOWCOLUMN + (col & 0x0F))
+        };
+        oled_commandList(cmd, sizeof(cmd));
+
+        const uint8_t dc = 0x40;
+        const size_t chunk = i2c_dev->maxBufferSize() - 1;
+        while (len) {
+            uint8_t n = len < chunk ? len : chunk;
+            i2c_dev->write(data, n, true, &dc, 1);
+            data += n;
+            len -= n;
+        }
+    });
+    i2c_dev->setSpeed(i2c_postclk);
+
+    // reset the dirty window the base class tracks for its own display()
+    window_x1 = 1024;
+    window_y1 = 1024;
+    window_x2 = -1;
+    window_y2 = -1;
+}
+
+void Partial_SH1106G::drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg) {
+    uint8_t g = !_cp437 && c >= 176 ? c + 1 : c; // drawChar()'s offset for the old font layout
+    if (!GlyphBlitter::pages(buffer, WIDTH, HEIGHT, rotation, x, y, g, fg, bg)) drawChar(x, y, c, fg, bg, 1);
+}
+
+void Partial_SH1106G::fillChecker(uint16_t color) {
+    PatternFill::pages(buffer, WIDTH, HEIGHT, rotation, color);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "displays/display_ssd1306.h"
+#ifdef TARGET_SSD1306
+
+void Partial_SSD1306::display() {
+    int16_t dy = rotation == 2 ? -scroll_hint : scroll_hint;
+    scroll_hint = 0;
+
+    if (wire == nullptr) { // SPI wiring isn't used by any board yet
+        Adafruit_SSD1306::display();
+        return;
+    }
+
+#if ARDUINO >= 157
+    wire->setClock(wireClk);
+#endif
+    // the start line wraps at the 64 RAM rows, so only a 64 row panel scrolls like the flusher's pages
+    if (!(rotation & 1) && HEIGHT == 64 && dy % 8 == 0 && flusher.scroll(buffer, dy / 8)) {
+        ssd1306_command(SSD1306_SETSTARTLINE | flusher.startPage() * 8);
+    }
+    flusher.flush(buffer, [this](uint8_t page, uint8_t col, const uint8_t* data, uint8_t len) {
+        // horizontal addressing mode (set by begin()): the window wraps inside page/column limits
+        const uint8_t cmd[] = {
+            SSD1306_PAGEADDR, page, page,
+            SSD1306_COLUMNADDR, col, static_cast<uint8_t>(col + len - 1)
+        };
+        ssd1306_commandList(cmd, sizeof(cmd));
+
+        while (len) {
+            uint8_t n = len < SSD1306_WIRE_CHUNK ? len : SSD1306_WIRE_CHUNK;
+            wire->beginTransmission(i2caddr);
+            wire->write(static_cast<uint8_t>(0x40));
+            wire->write(data, n);
+            wire->endTransmission();
+            data += n;
+            len -= n;
+        }
+    });
+#if ARDUINO >= 157
+    wire->setClock(restoreClk);
+#endif
+}
+
+void Partial_SSD1306::drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg) {
+    uint8_t g = !_cp437 && c >= 176 ? c + 1 : c; // drawChar()'s offset for the old font layout
+    if (!GlyphBlitter::pages(buffer, WIDTH, HEIGHT, rotation, x, y, g, fg, bg)) drawChar(x, y, c, fg, bg, 1);
+}
+
+void Partial_SSD1306::fillChecker(uint16_t color) {
+    PatternFill::pages(buffer, WIDTH, HEIGHT, rotation, color);
+}
+
+#endif
\ No newline at end of file
@@ -1,8 +1,250 @@
+#include <cstring>
+#include <utility>
+
 #include "displays/display_ssd1351.h"
 #ifdef TARGET_SSD1351
+#include "configuration.h"
+
+#if SSD1351_DEPTH != 16
+static Buffered_SSD1351* feeding = nullptr; // the display whose rows the DMA IRQ queues
+#endif
+
+Buffered_SSD1351::~Buffered_SSD1351() {
+    wait();
+#if SSD1351_DEPTH == 16
+    free(spare);
+#else
+    delete[] lines;
+#endif
+}
+
+void Buffered_SSD1351::begin() {
+    _display.begin();
+#if SSD1351_DEPTH != 16
+    if (lines == nullptr) lines = new uint16_t[2 * WIDTH];
+#endif
+
+#ifdef SSD1351_DMA
+    // the bus stays claimed while a frame is out, so a bus shared with the radio keeps blocking writes
+    dma = spi != nullptr && spi != extSPI;
+#endif
+    if (!dma) return;
+
+#if defined(ARDUINO_ARCH_RP2040)
+    spi_hw = spi == &SPI ? spi0 : spi1; // same guess Adafruit_SPITFT makes
+    dma_channel = dma_claim_unused_channel(false);
+    dma = dma_channel >= 0;
+#elif defined(SSD1351_DMA)
+    __HAL_RCC_DMA1_CLK_ENABLE();
+#endif
+
+#if SSD1351_DEPTH != 16 && defined(ARDUINO_ARCH_RP2040)
+    if (dma) {
+        dma_channel_set_irq0_enabled(dma_channel, true);
+        irq_add_shared_handler(DMA_IRQ_0, lineSent, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+#elif SSD1351_DEPTH != 16
+    HAL_NVIC_SetPriority(DMA1_Stream4_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream4_IRQn);
+#endif
+
+#if SSD1351_DEPTH == 16 && SSD1351_BUFFERS > 1
+    if (dma && spare == nullptr) spare = static_cast<uint16_t*>(malloc(WIDTH * HEIGHT * sizeof(uint16_t)));
+#endif
+}
+
+#if SSD1351_DEPTH == 16
+void Buffered_SSD1351::display() {
+    if (!dma) {
+        _display.drawRGBBitmap(0, 0, buffer, WIDTH, HEIGHT);
+        return;
+    }
+
+    wait();
+    const uint16_t* frame = buffer;
+    if (spare) { // keep drawing into a copy, partial redraws expect the last frame in there
+        std::swap(buffer, spare);
+        memcpy(buffer, spare, WIDTH * HEIGHT * sizeof(uint16_t));
+        frame = spare;
+    }
 
+    beginTransfer();
+    queue(frame, WIDTH * HEIGHT);
+    reading_canvas = spare == nullptr;
+}
+
+#else
 void Buffered_SSD1351::display() {
-    _display.drawRGBBitmap(0, 0, buffer, width(), height());
+    wait();
+
+    if (!dma) {
+        _display.startWrite();
+        _display.setAddrWindow(0, 0, WIDTH, HEIGHT);
+        for (uint16_t y = 0; y < HEIGHT; y++) {
+            expandLine(y, lines);
+            _display.writePixels(lines, WIDTH);
+        }
+        _display.endWrite();
+        return;
+    }
+
+    // the first two rows are expanded here, the IRQ queues each next one and expands the
+    // row after it while that is on the wire, so this returns after a single row of work
+    beginTransfer();
+    expandLine(0, lines);
+    if (HEIGHT > 1) expandLine(1, lines + WIDTH);
+    feeding = this;
+    next_row = 1;
+    reading_canvas = true; // rows are expanded from `buffer` until the last one is out
+    queue(lines, WIDTH);
+}
+
+void Buffered_SSD1351::feed() {
+    if (next_row >= HEIGHT) { // the last row is out, let the main loop release the bus
+        driver->wake();
+        return;
+    }
+
+    uint16_t row = next_row;
+    next_row = row + 1;
+    queue(lines + (row & 1) * WIDTH, WIDTH);
+    if (row + 1 < HEIGHT) expandLine(row + 1, lines + ((row + 1) & 1) * WIDTH); // the buffer just sent
+}
+
+void Buffered_SSD1351::lineSent() {
+    Buffered_SSD1351* d = feeding;
+    if (d == nullptr) return;
+#if defined(ARDUINO_ARCH_RP2040)
+    if (!dma_channel_get_irq0_status(d->dma_channel)) return; // shared with other channels
+    dma_channel_acknowledge_irq0(d->dma_channel);
+#elif defined(SSD1351_DMA)
+    DMA1->HIFCR = DMA_HIFCR_CTCIF4;
+#endif
+    d->feed();
+}
+
+#if defined(SSD1351_DMA) && !defined(ARDUINO_ARCH_RP2040)
+extern "C" void DMA1_Stream4_IRQHandler() {
+    Buffered_SSD1351::lineSent();
+}
+#endif
+#endif
+
+bool Buffered_SSD1351::busy() {
+    if (!sending) return false;
+#if SSD1351_DEPTH != 16
+    if (dma && next_row < HEIGHT) return true; // between rows the stream is briefly idle
+#endif
+    if (!transferDone()) return true;
+
+    finishTransfer();
+    return false;
+}
+
+void Buffered_SSD1351::wait() {
+    while (busy()) {}
+}
+
+void Buffered_SSD1351::fence() {
+    if (reading_canvas) wait();
+    else busy();
+}
+
+void Buffered_SSD1351::beginTransfer() {
+    _display.startWrite();
+    _display.setAddrWindow(0, 0, WIDTH, HEIGHT);
+
+    // 16-bit SPI frames go out MSB first, which is the byte order the panel wants
+#if defined(ARDUINO_ARCH_RP2040)
+    hw_write_masked(&spi_get_hw(spi_hw)->cr0, 15 << SPI_SSPCR0_DSS_LSB, SPI_SSPCR0_DSS_BITS);
+#elif defined(SSD1351_DMA)
+    SPI2->CR1 &= ~SPI_CR1_SPE;
+    SPI2->CR1 |= SPI_CR1_DFF | SPI_CR1_SPE;
+    SPI2->CR2 |= SPI_CR2_TXDMAEN;
+#endif
+
+    sending = true;
+}
+
+void Buffered_SSD1351::queue(const uint16_t* pixels, uint32_t count) {
+#if defined(ARDUINO_ARCH_RP2040)
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, spi_get_dreq(spi_hw, true));
+    dma_channel_configure(dma_channel, &c, &spi_get_hw(spi_hw)->dr, pixels, count, true);
+
+#elif defined(SSD1351_DMA)
+    DMA1_Stream4->CR = 0;
+    while (DMA1_Stream4->CR & DMA_SxCR_EN) {}
+    DMA1->HIFCR = DMA_HIFCR_CTCIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTEIF4 | DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CFEIF4;
+    DMA1_Stream4->PAR = reinterpret_cast<uint32_t>(&SPI2->DR);
+    DMA1_Stream4->M0AR = reinterpret_cast<uint32_t>(pixels);
+    DMA1_Stream4->NDTR = count;
+    DMA1_Stream4->FCR = 0; // direct mode
+    uint32_t irq = SSD1351_DEPTH != 16 ? DMA_SxCR_TCIE : 0; // rows are fed from the IRQ
+    DMA1_Stream4->CR = DMA_SxCR_DIR_0 | DMA_SxCR_MINC | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | irq | DMA_SxCR_EN; // channel 0: SPI2_TX
+#endif
+}
+
+bool Buffered_SSD1351::queueIdle() const {
+#if defined(ARDUINO_ARCH_RP2040)
+    return !dma_channel_is_busy(dma_channel);
+#elif defined(SSD1351_DMA)
+    return !(DMA1_Stream4->CR & DMA_SxCR_EN);
+#else
+    return true;
+#endif
+}
+
+bool Buffered_SSD1351::transferDone() const {
+#if defined(ARDUINO_ARCH_RP2040)
+    return queueIdle() && !spi_is_busy(spi_hw);
+#elif defined(SSD1351_DMA)
+    return queueIdle() && (SPI2->SR & SPI_SR_TXE) && !(SPI2->SR & SPI_SR_BSY);
+#else
+    return true;
+#endif
+}
+
+void Buffered_SSD1351::finishTransfer() {
+    // nothing reads RX during the transfer, drop what piled up and the overrun flag
+#if defined(ARDUINO_ARCH_RP2040)
+    while (spi_is_readable(spi_hw)) (void)spi_get_hw(spi_hw)->dr;
+    spi_get_hw(spi_hw)->icr = SPI_SSPICR_RORIC_BITS;
+    hw_write_masked(&spi_get_hw(spi_hw)->cr0, 7 << SPI_SSPCR0_DSS_LSB, SPI_SSPCR0_DSS_BITS);
+
+#elif defined(SSD1351_DMA)
+    SPI2->CR2 &= ~SPI_CR2_TXDMAEN;
+    DMA1->HIFCR = DMA_HIFCR_CTCIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTEIF4 | DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CFEIF4;
+    SPI2->CR1 &= ~(SPI_CR1_SPE | SPI_CR1_DFF);
+    SPI2->CR1 |= SPI_CR1_SPE;
+    (void)SPI2->DR;
+    (void)SPI2->SR;
+#endif
+
+    _display.endWrite();
+    sending = false;
+    reading_canvas = false;
+}
+
+#if SSD1351_DEPTH == 16
+void Buffered_SSD1351::drawGlyph(int16_t x, int16_t y, unsigned char c, uint16_t fg, uint16_t bg) {
+    uint8_t g = !_cp437 && c >= 176 ? c + 1 : c; // drawChar()'s offset for the old font layout
+    if (!GlyphBlitter::rgb565(buffer, WIDTH, HEIGHT, rotation, x, y, g, fg, bg)) drawChar(x, y, c, fg, bg, 1);
+}
+#endif
+
+#if SSD1351_DEPTH == 16
+void Buffered_SSD1351::fillChecker(uint16_t color) {
+    PatternFill::rgb565(buffer, WIDTH, HEIGHT, rotation, color);
+}
+#elif SSD1351_DEPTH == 8
+void Buffered_SSD1351::fillChecker(uint16_t color) {
+    PatternFill::bytes(buffer, WIDTH, HEIGHT, rotation, index(color));
 }
+#endif
 
 #endif
\ No newline at end of file
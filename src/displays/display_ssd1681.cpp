@@ -0,0 +1,19 @@
+#include "displays/display_ssd1681.h"
+#ifdef TARGET_SSD1681
+
+void Partial_SSD1681::refreshWindow(int16_t x, int16_t y, int16_t w, int16_t h, bool full) {
+    uint32_t area = static_cast<uint32_t>(width()) * height();
+    uint32_t cost = static_cast<uint32_t>(w) * h * 100 / area;
+    if (cost < SSD1681_GHOST_MIN) cost = SSD1681_GHOST_MIN;
+
+    if (full || ghosting + cost > SSD1681_GHOST_LIMIT) {
+        display(false);
+        ghosting = 0;
+        return;
+    }
+
+    displayWindow(x, y, w, h); // widened to whole bytes by GxEPD2
+    ghosting += cost;
+}
+
+#endif
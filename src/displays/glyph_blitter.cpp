@@ -0,0 +1,100 @@
+#include "displays/glyph_blitter.h"
+
+#include <glcdfont.c> // the same 5x7 font drawChar() uses; static there, so a copy of our own
+
+#define GLYPH_W 6
+#define GLYPH_H 8
+
+static bool fits(int16_t w, int16_t h, uint8_t rotation, int16_t x, int16_t y) {
+    if (rotation & 1) {
+        int16_t t = w;
+        w = h;
+        h = t;
+    }
+    return x >= 0 && y >= 0 && x + GLYPH_W <= w && y + GLYPH_H <= h;
+}
+
+static uint8_t reverse(uint8_t b, uint8_t n) {
+    uint8_t r = 0;
+    for (uint8_t i = 0; i < n; i++, b >>= 1) r = r << 1 | (b & 1);
+    return r;
+}
+
+// n vertical pixels of one column starting at row py; `paint` masks the ones to touch
+static void putBits(uint8_t* buf, int16_t w, int16_t px, int16_t py, uint8_t value, uint8_t paint) {
+    uint8_t* p = buf + (py >> 3) * w + px;
+    uint8_t shift = py & 7;
+
+    uint8_t mask = paint << shift;
+    *p = (*p & ~mask) | (value << shift & mask);
+    if (shift && (paint >> (8 - shift))) {
+        p += w;
+        mask = paint >> (8 - shift);
+        *p = (*p & ~mask) | (value >> (8 - shift) & mask);
+    }
+}
+
+
+/**********************/
+/**** GlyphBlitter ****/
+/**********************/
+uint8_t GlyphBlitter::column(uint8_t c, uint8_t i) {
+    return i < 5 ? font[c * 5 + i] : 0;
+}
+
+bool GlyphBlitter::pages(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation,
+                         int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg) {
+    if (fg > 1 || bg > 1 || !fits(w, h, rotation, x, y)) return false;
+
+    const uint8_t* glyph = font + c * 5;
+    const bool opaque = fg != bg;
+
+    if (rotation == 0 || rotation == 2) {
+        // glyph columns are page bytes already
+        for (uint8_t i = 0; i < GLYPH_W; i++) {
+            uint8_t ink = i < 5 ? glyph[i] : 0;
+            uint8_t paint = opaque ? 0xFF : ink;
+            uint8_t value = fg ? ink : (opaque ? ~ink : 0);
+            if (rotation == 0) putBits(buf, w, x + i, y, value, paint);
+            else               putBits(buf, w, w - 1 - x - i, h - GLYPH_H - y, reverse(value, 8), reverse(paint, 8));
+        }
+    } else {
+        // glyph rows become columns, 6 pixels tall
+        for (uint8_t j = 0; j < GLYPH_H; j++) {
+            uint8_t ink = 0;
+            for (uint8_t i = 0; i < 5; i++) ink |= (glyph[i] >> j & 1) << i;
+            uint8_t paint = opaque ? 0x3F : ink;
+            uint8_t value = (fg ? ink : (opaque ? ~ink : 0)) & 0x3F;
+            if (rotation == 1) putBits(buf, w, w - 1 - y - j, x, value, paint);
+            else               putBits(buf, w, y + j, h - GLYPH_W - x, reverse(value, 6), reverse(paint, 6));
+        }
+    }
+    return true;
+}
+
+bool GlyphBlitter::rgb565(uint16_t* buf, int16_t w, int16_t h, uint8_t rotation,
+                          int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg) {
+    if (!fits(w, h, rotation, x, y)) return false;
+
+    // where glyph pixel (0, 0) lands and how to step along a glyph row (di) and column (dj)
+    int32_t origin, di, dj;
+    switch (rotation) {
+        case 0:  origin = y * w + x;                            di = 1;  dj = w;  break;
+        case 1:  origin = x * w + (w - 1 - y);                  di = w;  dj = -1; break;
+        case 2:  origin = (h - 1 - y) * w + (w - 1 - x);        di = -1; dj = -w; break;
+        default: origin = (h - 1 - x) * w + y;                  di = -w; dj = 1;  break;
+    }
+
+    const uint8_t* glyph = font + c * 5;
+    uint16_t* column = buf + origin;
+    for (uint8_t i = 0; i < GLYPH_W; i++, column += di) {
+        uint8_t ink = i < 5 ? glyph[i] : 0;
+        uint16_t* p = column;
+        if (fg != bg) {
+            for (uint8_t j = 0; j < GLYPH_H; j++, p += dj, ink >>= 1) *p = ink & 1 ? fg : bg;
+        } else {
+            for (; ink; p += dj, ink >>= 1) if (ink & 1) *p = fg;
+        }
+    }
+    return true;
+}
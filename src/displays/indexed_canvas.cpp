@@ -0,0 +1,124 @@
+#include <cstring>
+
+#include "displays/indexed_canvas.h"
+
+static constexpr uint16_t rgb332To565(uint8_t i) {
+    uint16_t r = i >> 5 & 0x07, g = i >> 2 & 0x07, b = i & 0x03;
+    return (r << 2 | r >> 1) << 11 | (g << 3 | g) << 5 | (b << 3 | b << 1 | b >> 1);
+}
+
+struct Rgb332Lut {
+    uint16_t v[256];
+    constexpr Rgb332Lut() : v() {
+        for (int i = 0; i < 256; i++) v[i] = rgb332To565(i);
+    }
+};
+
+static constexpr Rgb332Lut rgb332_lut;
+
+
+/************************/
+/**** IndexedCanvas8 ****/
+/************************/
+void IndexedCanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    GFXcanvas8::drawPixel(x, y, index(color));
+}
+
+void IndexedCanvas8::fillScreen(uint16_t color) {
+    GFXcanvas8::fillScreen(index(color));
+}
+
+void IndexedCanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    GFXcanvas8::drawFastVLine(x, y, h, index(color));
+}
+
+void IndexedCanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    GFXcanvas8::drawFastHLine(x, y, w, index(color));
+}
+
+void IndexedCanvas8::expandLine(uint16_t y, uint16_t* out) const {
+    const uint8_t* row = getBuffer() + y * WIDTH;
+    for (int16_t x = 0; x < WIDTH; x++) out[x] = rgb332_lut.v[row[x]];
+}
+
+
+/************************/
+/**** IndexedCanvas4 ****/
+/************************/
+IndexedCanvas4::IndexedCanvas4(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), buffer(new uint8_t[(w + 1) / 2 * h]()) {
+    used = 1; // the zeroed buffer is all index 0, black
+}
+
+uint8_t IndexedCanvas4::nearest(uint16_t color) const {
+    int16_t r = color >> 11, g = color >> 5 & 0x3F, b = color & 0x1F;
+
+    uint8_t best = 0;
+    uint32_t best_distance = UINT32_MAX;
+    for (uint8_t i = 0; i < used; i++) {
+        int16_t dr = 2 * (r - (palette[i] >> 11));
+        int16_t dg = g - (palette[i] >> 5 & 0x3F);
+        int16_t db = 2 * (b - (palette[i] & 0x1F));
+        uint32_t distance = dr * dr + dg * dg + db * db;
+        if (distance < best_distance) {
+            best = i;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+uint8_t IndexedCanvas4::index(uint16_t color) {
+    if (color == last_color) return last_index;
+
+    uint8_t i = 0;
+    while (i < used && palette[i] != color) i++;
+    if (i == used) {
+        if (used < 16) {
+            palette[used++] = color;
+            pairs_valid = false;
+        } else {
+            i = nearest(color);
+        }
+    }
+
+    last_color = color;
+    last_index = i;
+    return i;
+}
+
+void IndexedCanvas4::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+
+    int16_t t;
+    switch (rotation) {
+        case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+        case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+        case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+    }
+
+    uint8_t& cell = buffer[y * ((WIDTH + 1) / 2) + x / 2];
+    uint8_t i = index(color);
+    cell = x & 1 ? (cell & 0xF0) | i : (cell & 0x0F) | i << 4;
+}
+
+void IndexedCanvas4::fillScreen(uint16_t color) {
+    // nothing on screen refers to the old entries any more
+    palette[0] = color;
+    used = 1;
+    last_color = color;
+    last_index = 0;
+    pairs_valid = false;
+    memset(buffer, 0, (WIDTH + 1) / 2 * HEIGHT);
+}
+
+void IndexedCanvas4::expandLine(uint16_t y, uint16_t* out) {
+    if (!pairs_valid) {
+        for (uint16_t b = 0; b < 256; b++) pairs[b] = palette[b >> 4] | static_cast<uint32_t>(palette[b & 0x0F]) << 16;
+        pairs_valid = true;
+    }
+
+    const uint8_t* row = buffer + y * ((WIDTH + 1) / 2);
+    for (int16_t x = 0; x + 1 < WIDTH; x += 2) memcpy(out + x, &pairs[*row++], sizeof(uint32_t));
+    if (WIDTH & 1) out[WIDTH - 1] = palette[*row >> 4];
+}
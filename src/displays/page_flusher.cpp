@@ -0,0 +1,58 @@
+#include <cstring>
+
+#include "displays/page_flusher.h"
+
+/*********************/
+/**** PageFlusher ****/
+/*********************/
+uint16_t PageFlusher::cost(const uint8_t* frame, uint8_t from) const {
+    uint16_t n = 0;
+    for (uint8_t p = 0; p < pages; p++) {
+        const uint8_t* row = frame + p * width;
+        const uint8_t* copy = shadow + (p + from) % pages * width;
+        for (uint16_t c = 0; c < width; c++) n += row[c] != copy[c];
+    }
+    return n;
+}
+
+bool PageFlusher::scroll(const uint8_t* frame, int8_t by) {
+    if (!valid || by % pages == 0) return false;
+
+    uint8_t moved = ((start + by) % pages + pages) % pages;
+    if (cost(frame, moved) >= cost(frame, start)) return false;
+
+    start = moved;
+    return true;
+}
+
+uint16_t PageFlusher::flush(const uint8_t* frame, Sink sink) {
+    uint16_t sent = 0;
+
+    for (uint8_t p = 0; p < pages; p++) {
+        uint8_t ram = (p + start) % pages;
+        const uint8_t* row = frame + p * width;
+        uint8_t* copy = shadow + ram * width;
+        int16_t first = -1, last = -1;
+
+        for (uint16_t c = 0; c < width; c++) {
+            if (valid && row[c] == copy[c]) continue;
+
+            if (first >= 0 && c - last - 1 > PAGE_FLUSH_GAP) {
+                sink(ram, first, row + first, last - first + 1);
+                sent += last - first + 1;
+                first = -1;
+            }
+            if (first < 0) first = c;
+            last = c;
+        }
+
+        if (first >= 0) {
+            sink(ram, first, row + first, last - first + 1);
+            sent += last - first + 1;
+        }
+        memcpy(copy, row, width);
+    }
+
+    valid = true;
+    return sent;
+}
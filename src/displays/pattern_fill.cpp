@@ -0,0 +1,49 @@
+#include "displays/pattern_fill.h"
+
+// added to raw x + y to get the parity of the rotated x + y
+static uint8_t phase(int16_t w, int16_t h, uint8_t rotation) {
+    switch (rotation & 3) {
+        case 1:  return (w - 1) & 1;
+        case 2:  return (w + h) & 1;
+        case 3:  return (h - 1) & 1;
+        default: return 0;
+    }
+}
+
+
+/*********************/
+/**** PatternFill ****/
+/*********************/
+void PatternFill::pages(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation, uint16_t color) {
+    uint8_t first = phase(w, h, rotation) ? 0x55 : 0xAA; // odd rows in even columns, pages start on even rows
+    uint16_t n = (h + 7) / 8;
+
+    for (uint16_t page = 0; page < n; page++) {
+        uint8_t* p = buf + page * w;
+        uint8_t rows = page == n - 1 && h % 8 ? (1 << h % 8) - 1 : 0xFF; // rows past the panel stay as they are
+        uint8_t mask = first;
+        for (int16_t x = 0; x < w; x++, mask ^= 0xFF) {
+            switch (color) {
+                case 0:  p[x] &= ~(mask & rows); break;
+                case 1:  p[x] |= mask & rows; break;
+                default: p[x] ^= mask & rows; break;
+            }
+        }
+    }
+}
+
+void PatternFill::bytes(uint8_t* buf, int16_t w, int16_t h, uint8_t rotation, uint8_t value) {
+    uint8_t k = phase(w, h, rotation);
+    for (int16_t y = 0; y < h; y++) {
+        uint8_t* row = buf + y * w;
+        for (int16_t x = (y + k + 1) & 1; x < w; x += 2) row[x] = value;
+    }
+}
+
+void PatternFill::rgb565(uint16_t* buf, int16_t w, int16_t h, uint8_t rotation, uint16_t color) {
+    uint8_t k = phase(w, h, rotation);
+    for (int16_t y = 0; y < h; y++) {
+        uint16_t* row = buf + y * w;
+        for (int16_t x = (y + k + 1) & 1; x < w; x += 2) row[x] = color;
+    }
+}
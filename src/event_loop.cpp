@@ -0,0 +1,99 @@
+#include "event_loop.h"
+#include "configuration.h"
+
+void EventLoop::insert(int8_t id) {
+    uint8_t i = active;
+    while (i > 0 && static_cast<int32_t>(timers[order[i-1]].deadline - timers[id].deadline) > 0) {
+        order[i] = order[i-1];
+        i--;
+    }
+    order[i] = id;
+    active++;
+}
+
+void EventLoop::remove(int8_t id) {
+    for (uint8_t i = 0; i < active; i++) {
+        if (order[i] != id) continue;
+        for (uint8_t j = i; j + 1 < active; j++) order[j] = order[j+1];
+        active--;
+        return;
+    }
+}
+
+int8_t EventLoop::schedule(uint32_t delay, uint32_t period, Delegate<void()> fn) {
+    for (int8_t id = 0; id < EVENT_TIMERS; id++) {
+        if (timers[id].active) continue;
+        timers[id] = Timer{millis() + delay, period, true, fn};
+        insert(id);
+        return id;
+    }
+    return EVENT_NO_TIMER;
+}
+
+void EventLoop::reschedule(int8_t id, uint32_t ms) {
+    if (!scheduled(id)) return;
+    remove(id);
+    timers[id].deadline = millis() + ms;
+    insert(id);
+}
+
+void EventLoop::cancel(int8_t id) {
+    if (!scheduled(id)) return;
+    remove(id);
+    timers[id].active = false;
+}
+
+bool EventLoop::post(const Event& e) {
+    return queue.push(e);
+}
+
+void EventLoop::signal(EventType type) {
+    signals |= 1UL << static_cast<uint8_t>(type);
+    driver->wake();
+}
+
+void EventLoop::dispatch(const Event& e) {
+    auto& handler = handlers[static_cast<uint8_t>(e.type)];
+    if (handler) handler(e);
+}
+
+uint32_t EventLoop::untilNext(uint32_t now) const {
+    if (!active) return EVENT_MAX_SLEEP;
+    int32_t left = static_cast<int32_t>(timers[order[0]].deadline - now);
+    if (left <= 0) return 0;
+    return std::min<uint32_t>(left, EVENT_MAX_SLEEP);
+}
+
+void EventLoop::run() {
+    uint32_t now = millis();
+
+    noInterrupts();
+    uint32_t pending = signals;
+    signals = 0;
+    interrupts();
+    for (uint8_t t = 1; t < static_cast<uint8_t>(EventType::COUNT); t++) {
+        if (pending >> t & 1) dispatch(Event{static_cast<EventType>(t), 0, now});
+    }
+
+    while (active && static_cast<int32_t>(timers[order[0]].deadline - now) <= 0) {
+        int8_t id = order[0];
+        remove(id);
+        Timer& timer = timers[id];
+        auto fn = timer.fn; // the slot may be reused from inside the callback
+        if (timer.period) {
+            timer.deadline += timer.period;
+            if (static_cast<int32_t>(timer.deadline - now) <= 0) timer.deadline = now + timer.period; // don't burst after a stall
+            insert(id);
+        } else {
+            timer.active = false;
+        }
+        fn();
+    }
+
+    Event e;
+    while (queue.pop(e)) dispatch(e);
+
+    if (signals || !queue.empty()) return;
+    uint32_t wait = untilNext(millis());
+    if (wait) driver->idle(wait * 1000);
+}
@@ -0,0 +1,71 @@
+#if defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_STM32)
+#include <algorithm>
+#include <malloc.h>
+#include <reent.h>
+#include <unistd.h>
+
+#include "configuration.h"
+
+#define STACK_PAINT     0xA5A5A5A5
+#define STACK_MARGIN    32          // words left alone below the painting frame
+#define CHUNK_OVERHEAD  8           // malloc header + alignment
+
+struct FreeChunk { // newlib-nano's chunk header
+    long size;
+    FreeChunk* next;
+};
+
+extern "C" {
+void __malloc_lock(struct _reent* r);
+void __malloc_unlock(struct _reent* r);
+__attribute__((weak)) extern FreeChunk* __malloc_free_list; // only with newlib-nano
+}
+
+static uintptr_t heapTop() {
+    return reinterpret_cast<uintptr_t>(sbrk(0));
+}
+
+uint32_t DriverBase::heapUsed() {
+    return mallinfo().uordblks;
+}
+
+uint32_t DriverBase::heapArena() {
+    return mallinfo().arena;
+}
+
+uint32_t DriverBase::heapFree(uintptr_t limit) {
+    uintptr_t top = heapTop();
+    return (limit > top ? limit - top : 0) + mallinfo().fordblks;
+}
+
+uint32_t DriverBase::heapLargest(uintptr_t limit) {
+    uintptr_t top = heapTop();
+    uint32_t wild = limit > top ? limit - top : 0;
+    uint32_t largest = wild;
+
+    if (&__malloc_free_list) {
+        __malloc_lock(_REENT);
+        for (FreeChunk* c = __malloc_free_list; c; c = c->next) {
+            uint32_t size = c->size;
+            if (reinterpret_cast<uintptr_t>(c) + size == top) size += wild; // the last chunk can still grow
+            largest = std::max(largest, size);
+        }
+        __malloc_unlock(_REENT);
+    } else {
+        largest += mallinfo().keepcost; // full newlib only exposes the top chunk
+    }
+    return largest > CHUNK_OVERHEAD ? largest - CHUNK_OVERHEAD : 0;
+}
+
+void DriverBase::fillStack(uint32_t* bottom) {
+    uint32_t* end = static_cast<uint32_t*>(__builtin_frame_address(0)) - STACK_MARGIN;
+    for (volatile uint32_t* p = bottom; p < end; p++) *p = STACK_PAINT;
+}
+
+uint32_t DriverBase::stackUsed(const uint32_t* bottom, const uint32_t* top) {
+    const uint32_t* p = bottom;
+    while (p < top && *p == STACK_PAINT) p++;
+    return (top - p) * sizeof(uint32_t);
+}
+
+#endif
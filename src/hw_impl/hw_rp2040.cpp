@@ -8,6 +8,12 @@ SPIClassRP2040* extSPI1 = &SPI1;
 
 DriverBase* driver = new DriverRP2040();
 
+// stacks live in the scratch banks: core0 in SCRATCH_Y, core1 in SCRATCH_X
+extern uint32_t __StackBottom, __StackTop, __StackOneBottom, __StackOneTop;
+extern char __HeapLimit;
+static uint32_t* stackBottom(uint8_t core)  { return core ? &__StackOneBottom : &__StackBottom; }
+static uint32_t* stackTop(uint8_t core)     { return core ? &__StackOneTop : &__StackTop; }
+
 uint32_t DriverRP2040::currentClock() const {
     return clock_get_hz(clk_sys);
 }
@@ -17,10 +23,7 @@ uint32_t DriverRP2040::currentRam() const {
     extern char __data_start__, __data_end__;
     size_t static_used = (&__bss_end__ - &__bss_start__) + (&__data_end__ - &__data_start__);
 
-    struct mallinfo m = mallinfo();
-    size_t heap_used = m.uordblks;
-
-    return static_used + heap_used;
+    return static_used + heapUsed() + stackHighWater(0) + stackHighWater(1);
 }
 uint32_t DriverRP2040::currentFlash() const {
     extern char __flash_binary_start, __flash_binary_end;
@@ -55,4 +58,37 @@ void DriverRP2040::reboot() {
     while (true);
 }
 
+void DriverRP2040::idle(uint32_t us) {
+    // SEV from wake() is latched, so an IRQ right before WFE is not lost
+    best_effort_wfe_or_timeout(make_timeout_time_us(us));
+}
+
+void DriverRP2040::wake() {
+    __sev();
+}
+
+uint32_t DriverRP2040::freeHeap() const {
+    return heapFree(reinterpret_cast<uintptr_t>(&__HeapLimit));
+}
+
+uint32_t DriverRP2040::largestFreeBlock() const {
+    return heapLargest(reinterpret_cast<uintptr_t>(&__HeapLimit));
+}
+
+uint32_t DriverRP2040::heapHighWater() const {
+    return heapArena();
+}
+
+uint32_t DriverRP2040::stackSize(uint8_t core) const {
+    return core < 2 ? (stackTop(core) - stackBottom(core)) * sizeof(uint32_t) : 0;
+}
+
+uint32_t DriverRP2040::stackHighWater(uint8_t core) const {
+    return core < 2 ? stackUsed(stackBottom(core), stackTop(core)) : 0;
+}
+
+void DriverRP2040::paintStack() {
+    fillStack(stackBottom(get_core_num())); // only the calling core's own stack is safe to paint
+}
+
 #endif
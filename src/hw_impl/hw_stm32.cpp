@@ -13,20 +13,22 @@ SPIClass* extSPI1 = extSPI;
 
 DriverBase* driver = new DriverSTM32();
 
+// the stack owns the top _Min_Stack_Size bytes, sbrk stops the heap right below
+extern uint32_t _estack, _Min_Stack_Size;
+static uint32_t* stackTop()     { return &_estack; }
+static uint32_t* stackBottom()  { return reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(&_estack) - reinterpret_cast<uintptr_t>(&_Min_Stack_Size)); }
+
 uint32_t DriverSTM32::currentClock() const {
     return SystemCoreClock;
 }
 
 uint32_t DriverSTM32::currentRam() const {
-    extern uint32_t _sdata, _edata, _sbss, _ebss;
-    extern uint32_t _Min_Stack_Size, _Min_Heap_Size;
+    extern char _sdata, _edata, _sbss, _ebss;
 
     uint32_t data = &_edata - &_sdata;
     uint32_t bss = &_ebss - &_sbss;
-    uint32_t stack = (uint32_t) &_Min_Stack_Size;
-    uint32_t heap = (uint32_t) &_Min_Heap_Size;
 
-    return data + bss + stack + heap;
+    return data + bss + heapUsed() + stackHighWater(0);
 }
 
 uint32_t DriverSTM32::currentFlash() const {
@@ -52,6 +54,81 @@ void DriverSTM32::reboot() {
     NVIC_SystemReset();
 }
 
+void DriverSTM32::idle(uint32_t us) {
+    // Tickless: SysTick is stretched over the whole sleep instead of waking us every ms,
+    // then millis() is caught up by the time that passed. WFI with PRIMASK set still wakes
+    // on a pending IRQ, and handlers only run once the tick is back to 1ms.
+    uint32_t per_tick = SysTick->LOAD + 1;
+    uint32_t ticks = us / 1000;
+    if (ticks > SysTick_LOAD_RELOAD_Msk / per_tick) ticks = SysTick_LOAD_RELOAD_Msk / per_tick; // 24-bit counter
+
+    __disable_irq();
+    if (woken || ticks < 2 || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) { // a tick is already due
+        if (!woken) __WFI();
+        woken = false;
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    uint32_t reload = SysTick->VAL + (ticks - 1) * per_tick;
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = per_tick - 1; // takes effect at the next reload
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    uint32_t ctrl = SysTick->CTRL; // reading clears COUNTFLAG
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+    uint32_t left = SysTick->VAL;  // cycles until the last stretched tick
+    uint32_t slept;
+    if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) || left == 0) {
+        slept = ticks - 1; // ran out; the pending SysTick IRQ counts the last one
+    } else { // woken early: finish the current tick, then back to 1ms
+        slept = ticks - (left + per_tick - 1) / per_tick;
+        uint32_t rest = (left - 1) % per_tick + 1;
+        SysTick->LOAD = (rest < 2 ? 2 : rest) - 1; // 0 would stop the counter
+    }
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = per_tick - 1;
+    while (slept--) HAL_IncTick();
+
+    woken = false;
+    __enable_irq();
+}
+
+void DriverSTM32::wake() {
+    woken = true;
+}
+
+uint32_t DriverSTM32::freeHeap() const {
+    return heapFree(reinterpret_cast<uintptr_t>(stackBottom()));
+}
+
+uint32_t DriverSTM32::largestFreeBlock() const {
+    return heapLargest(reinterpret_cast<uintptr_t>(stackBottom()));
+}
+
+uint32_t DriverSTM32::heapHighWater() const {
+    return heapArena();
+}
+
+uint32_t DriverSTM32::stackSize(uint8_t core) const {
+    return core == 0 ? (stackTop() - stackBottom()) * sizeof(uint32_t) : 0;
+}
+
+uint32_t DriverSTM32::stackHighWater(uint8_t core) const {
+    return core == 0 ? stackUsed(stackBottom(), stackTop()) : 0;
+}
+
+void DriverSTM32::paintStack() {
+    fillStack(stackBottom());
+}
+
 #ifdef STM32WB55xx
 void SystemClock_Config(void) {
     RCC_OscInitTypeDef RCC_OscInitStruct = {};
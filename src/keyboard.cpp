@@ -0,0 +1,34 @@
+#include "keyboard.h"
+
+void Keyboard::begin(TwoWire* w, uint8_t addr, int16_t pin, void (*isr)()) {
+    wire = w;
+    address = addr;
+    int_pin = isr ? pin : -1;
+
+    if (int_pin >= 0) {
+        pinMode(int_pin, INPUT_PULLUP);
+        attachInterrupt(digitalPinToInterrupt(int_pin), isr, FALLING);
+    }
+}
+
+uint8_t Keyboard::read(uint32_t now) {
+    if (!wire) return 0;
+
+    uint8_t n = 0;
+    while (n < KEYBOARD_BUFFER) {
+        wire->requestFrom(address, static_cast<uint8_t>(1));
+        if (!wire->available()) break;
+        char c = wire->read();
+        if (c == 0) break;
+
+        if (keys.push(KeyEvent{c, now})) n++;
+        else dropped++;
+    }
+
+    if (n) last_key = now;
+    return n;
+}
+
+uint32_t Keyboard::pollInterval(uint32_t now) const {
+    return now - last_key < KEYBOARD_FAST_FOR ? KEYBOARD_POLL_FAST : KEYBOARD_POLL_SLOW;
+}
@@ -3,215 +3,688 @@
 #include <RadioLib.h>
 #include <vector>
 
+#include "alloc_tracker.h"
+#include "boot_log.h"
 #include "configuration.h"
+#include "cores.h"
+#include "event_loop.h"
+#include "keyboard.h"
 #include "keycodes.h"
+#include "probe.h"
 #include "settings.h"
 #include "utils.h"
 
+#include "network/link.h"
 #include "network/packet.h"
 #include "network/packet_types.h"
 
 #include "ui/base.h"
 #include "ui/extra.h"
+#include "ui/frame_scheduler.h"
 #include "ui/inputs.h"
 #include "ui/modals.h"
 #include "ui/stackers.h"
+#include "ui/static_menu.h"
 #include "ui/static.h"
 
 #if   defined(TARGET_SH1106)
-Adafruit_SH1106G display(128, 64, extI2C, -1);
+Partial_SH1106G display(128, 64, extI2C, -1);
 #elif defined(TARGET_SSD1306)
-Adafruit_SSD1306 display(128, 64, extI2C, -1);
+Partial_SSD1306 display(128, 64, extI2C, -1);
 #elif defined(TARGET_ST7567)
 ST7567 display(128, 64, extSPI1, DISPLAY_DC, DISPLAY_RESET, DISPLAY_CS);
 #elif defined(TARGET_SSD1351)
 Buffered_SSD1351 display(128, 128, extSPI1, DISPLAY_CS, DISPLAY_DC, DISPLAY_RESET);
 #elif defined(TARGET_SSD1681)
-GxEPD2_BW<GxEPD2_154_D67, GxEPD2_154_D67::HEIGHT> display = GxEPD2_154_D67(DISPLAY_CS, DISPLAY_DC, DISPLAY_RESET, DISPLAY_BUSY);
+Partial_SSD1681 display(GxEPD2_154_D67(DISPLAY_CS, DISPLAY_DC, DISPLAY_RESET, DISPLAY_BUSY));
 #endif
 
 
 SX1262 radio = new Module(RADIO_CS, RADIO_IRQ, RADIO_RESET, RADIO_BUSY, *extSPI);
 
 NetManager netman;
+CoreLink core_link;
+EventLoop events;
+#ifdef DUAL_CORE
+EventLoop radio_events;
+#else
+EventLoop& radio_events = events;
+#endif
+Keyboard keyboard;
 UIContext ui_context(display);
-std::vector<String> bands = {"B1@LP","B2@GP","B3@GP","B4@LP","B5@HP","B6@SP","B7@GP"};
 std::vector<float> bandwidths_float = {62.5, 125.0, 250.0, 500.0 };
-std::vector<String> bandwidths = {"62.5kHz", "125.0kHz", "250.0kHz", "500.0kHz" };
 
-uint32_t last_update;
-volatile bool received_flag = false;
+FrameScheduler frames(DISPLAY_MAX_FPS);
+int8_t frame_timer = EVENT_NO_TIMER;
+int8_t net_timer = EVENT_NO_TIMER;
+int8_t keyboard_timer = EVENT_NO_TIMER;
+uint32_t keyboard_due = 0;  // next poll from serviceUi() while there's no timer slot for it
 volatile bool enable_interrupt = true;
+volatile uint32_t irq_time = 0;
+
+BootLog boot;
+bool first_frame = false;
+bool radio_ready = false;
+char pending_message[MESSAGE_LENGTH];
+
+void handleUiFrame(LinkFrame& f);
+void handleRadioFrame(LinkFrame& f);
+void setupRadio();
+#ifdef DUAL_CORE
+void setup1();
+void loop1();
+#endif
+
+// The radio side runs on core1 on DUAL_CORE builds and inline otherwise;
+// the UI side only ever reaches it through these two.
+bool toRadio(LinkFrame& f) {
+#ifdef DUAL_CORE
+    if (!core_link.toRadio(f)) return false;
+    wakeCores();
+#else
+    handleRadioFrame(f);
+#endif
+    return true;
+}
 
+void toUi(LinkFrame& f) {
+#ifdef DUAL_CORE
+    if (core_link.toUi(f)) wakeCores();
+#else
+    handleUiFrame(f);
+#endif
+}
+
+
+/********************/
+/**** Radio side ****/
+/********************/
 void setFlag() {
+    irq_time = micros(); // TX/RX done timestamp for TDMA sync
     if (!enable_interrupt) return;
-    received_flag = true;
+    radio_events.signal(EventType::RADIO);
 }
 
+void netTick();
 
-auto message_menu = MenuView::make().fill(FillMode::TOP).buildPtr();
-UIApp root = UIApp::make().title("\xAD\x99\x9A               \x9D\xA1\xA3").root(
-    MenuView::make().title("Radio").children({
-        TabSelector::make().icon('\x8C').title("Broadcast").children({
-            TextField::make().title(">").spacer(false).maxLength(MESSAGE_LENGTH-1).onSubmit([](char* buf) {
-                if (!strlen(buf)) return;
-                enable_interrupt = false;
-
-                int16_t ch_status = radio.scanChannel();
-                if (ch_status == RADIOLIB_CHANNEL_FREE) {
-                    int16_t tx_status = radio.transmit(buf);
-                    if (tx_status == RADIOLIB_ERR_NONE) {
-                        message_menu->addChild(Label::make().icon('\xBD').title(buf).buildPtr());
-                    } else {
-                        root.addModal(Alert::make().message("Err: " + String(tx_status)).buildPtr());
-                    }
-                } else if (ch_status == RADIOLIB_LORA_DETECTED) { // maybe remove detection at all?
-                    root.addModal(ConfirmModal::make().message("Busy channel" + String(ch_status)).onConfirm([buf] {
-                        int16_t tx_status = radio.transmit(buf);
-                        if (tx_status == RADIOLIB_ERR_NONE) {
-                            message_menu->addChild(Label::make().icon('\xBD').title(buf).buildPtr());
-                        } else {
-                            root.addModal(Alert::make().message("Err: " + String(tx_status)).buildPtr());
-                        }
-                    }).buildPtr());
-                } else {
-                    root.addModal(Alert::make().message("Err: " + String(ch_status)).buildPtr());
-                }
-
-                enable_interrupt = true;
-                radio.startReceive();
-            }).buildPtr(),
-            message_menu
-        }).buildPtr(),
+void scheduleNet() {
+    radio_events.cancel(net_timer);
+    net_timer = EVENT_NO_TIMER;
 
-        MenuView::make().icon('\x8D').title("Settings").children({
-            MenuView::make().icon('\xAD').title("Radio").children({
-                NumberPicker<float>::make().icon('\x90').title("Freq").suffix("mHz").pointer(&settings.data.radio_frequency).min(863.000).max(870.000).precision(3).cursor(3).buildPtr(),
-                Selector::make().icon('\x1D').title("Bandw").pointer(&settings.data.radio_bandwidth).items(bandwidths).buildPtr(),
-                NumberPicker<uint8_t>::make().icon('\x12').title("SF").pointer(&settings.data.radio_sf).min(5).max(12).buildPtr(),
-                NumberPicker<uint8_t>::make().icon('\xAF').title("CR").pointer(&settings.data.radio_cr).min(5).max(8).buildPtr(),
-                NumberPicker<int8_t>::make().icon('\x8C').title("Power").suffix("dBm").pointer(&settings.data.radio_power).min(-9).max(22).buildPtr(),
-                Selector::make().icon('x').title("Band").pointer(&settings.data.radio_band).items(bands).buildPtr()
-            }).onExit([] {
-                settings.save();
-                radio.setFrequency(settings.data.radio_frequency);
-                radio.setBandwidth(bandwidths_float[settings.data.radio_bandwidth]);
-                radio.setSpreadingFactor(settings.data.radio_sf);
-                radio.setCodingRate(settings.data.radio_cr);
-                radio.setOutputPower(settings.data.radio_power);
-            }).buildPtr(),
-            MenuView::make().icon('\x95').title("Display").children({
+    uint32_t wait = netman.nextTick();
+    if (wait != NET_IDLE) net_timer = radio_events.after((wait + 999) / 1000, netTick);
+}
+
+void netTick() {
+    ALLOC_SCOPE(AllocTag::TX);
+    net_timer = EVENT_NO_TIMER;
+    netman.tick();
+    scheduleNet();
+}
+
+int16_t configureNetwork() {
+    netman.configure(static_cast<NetMode>(settings.data.net_mode), settings.data.tdma_slots,
+                     settings.data.tdma_slot, driver->boardId(), MESSAGE_LENGTH);
+    netman.configureHopping(settings.data.net_hopping, BAND_START, BAND_END,
+                            bandwidths_float[settings.data.radio_bandwidth], settings.data.radio_frequency,
+                            crc32(reinterpret_cast<const uint8_t*>(settings.data.net_key), strlen(settings.data.net_key)));
+    scheduleNet();
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t applyRadio() {
+    int16_t state = radio.setFrequency(settings.data.radio_frequency);
+    if (state == RADIOLIB_ERR_NONE) state = radio.setBandwidth(bandwidths_float[settings.data.radio_bandwidth]);
+    if (state == RADIOLIB_ERR_NONE) state = radio.setSpreadingFactor(settings.data.radio_sf);
+    if (state == RADIOLIB_ERR_NONE) state = radio.setCodingRate(settings.data.radio_cr);
+    if (state == RADIOLIB_ERR_NONE) state = radio.setOutputPower(settings.data.radio_power);
+    configureNetwork();
+    return state;
+}
+
+int16_t beginRadio() {
+    int16_t state = radio.begin(settings.data.radio_frequency, bandwidths_float[settings.data.radio_bandwidth],
+                                settings.data.radio_sf, settings.data.radio_cr,
+                                RADIOLIB_SX126X_SYNC_WORD_PRIVATE,
+                                settings.data.radio_power,
+                                8, 1.6, false);
+    radio.setCurrentLimit(60.0);
+    radio.setDio2AsRfSwitch(true);
+    radio.explicitHeader();
+    radio.setCRC(1);
+    radio.setDio1Action(setFlag); // the DIO1 interrupt lands on the core that calls this
+    radio.startReceive();
+
+    netman.begin(&radio, &enable_interrupt, &irq_time);
+    configureNetwork();
+    radio_ready = state == RADIOLIB_ERR_NONE;
+    return state;
+}
+
+int16_t sendHello() {
+    HelloPacket packet;
+    packet.hwid(driver->boardId());
+    return netman.send(packet);
+}
+
+int16_t transmitMessage(const uint8_t* data, size_t len, bool sense) {
+    ALLOC_SCOPE(AllocTag::TX);
+    if (netman.slotted()) { // no need to sense the channel in own slot
+        int16_t status = netman.send(data, len);
+        scheduleNet();
+        return status;
+    }
+
+    if (sense) {
+        enable_interrupt = false;
+        int16_t ch_status = radio.scanChannel();
+        enable_interrupt = true;
+        if (ch_status != RADIOLIB_CHANNEL_FREE) {
+            radio.startReceive();
+            return ch_status;
+        }
+    }
+    return netman.send(data, len);
+}
+
+void receivePacket() {
+    ALLOC_SCOPE(AllocTag::RX);
+    LinkFrame f;
+    f.op = LinkOp::RECEIVED;
+
+    enable_interrupt = false;
+    f.time = irq_time;
+    f.len = radio.getPacketLength();
+    {
+        PROBE("rx read");
+        radio.readData(f.data, f.len);
+    }
+    radio.startReceive();
+    enable_interrupt = true;
+
+    Packet* packet = Packet::parse(f.data, f.len);
+    if (packet) netman.handle(*packet, f.time);
+    delete packet;
+
+    toUi(f);
+}
+
+void handleRadioFrame(LinkFrame& f) {
+    switch (f.op) {
+        case LinkOp::SEND:
+            f.status = radio_ready ? transmitMessage(f.data, f.len, f.flag) : RADIOLIB_ERR_CHIP_NOT_FOUND;
+            f.op = LinkOp::SENT;
+            toUi(f);
+            break;
+        case LinkOp::CALL:
+            f.status = f.fn();
+            if (!f.done) break;
+            f.op = LinkOp::REPLY;
+            toUi(f);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/*****************/
+/**** UI side ****/
+/*****************/
+void keyboardIrq() {
+    events.signal(EventType::KEY);
+}
+
+bool postRadio(Delegate<int16_t()> fn, Delegate<void(int16_t)> done = nullptr) {
+    LinkFrame f;
+    f.op = LinkOp::CALL;
+    f.fn = fn;
+    f.done = done;
+    return toRadio(f);
+}
+
+void sendMessage(const char* text, bool sense);
+
+MenuView* message_menu = nullptr;
+char message_log[MESSAGE_HISTORY][MESSAGE_LOG_LENGTH];
+uint32_t messages_logged = 0;
+
+uint16_t messageCount() { return std::min<uint32_t>(messages_logged, MESSAGE_HISTORY); }
+const char* loggedMessage(uint16_t i) { // 0 is the oldest still kept
+    return message_log[(messages_logged - messageCount() + i) % MESSAGE_HISTORY];
+}
+UIApp root = UIApp::make().title("\xAD\x99\x9A               \x9D\xA1\xA3").build();
+
+/**********************/
+/**** Static menus ****/
+/**********************/
+constexpr const char* band_names[] = {"B1@LP","B2@GP","B3@GP","B4@LP","B5@HP","B6@SP","B7@GP"};
+constexpr const char* bandwidth_names[] = {"62.5kHz", "125.0kHz", "250.0kHz", "500.0kHz"};
+constexpr const char* net_mode_names[] = {"ALOHA", "TDMA", "TDMA crd"};
+
+void hwMcu(char* buf, size_t len)   { snprintf(buf, len, "%s", HW_MCU); }
+void hwClock(char* buf, size_t len) { prettyValue(buf, len, HW_F_CPU, "Hz", 0, 1000); }
+void hwRam(char* buf, size_t len)   { prettyValue(buf, len, HW_RAM_BYTES, "B", 0, 1024); }
+void hwFlash(char* buf, size_t len) { prettyValue(buf, len, HW_FLASH_BYTES, "B", 0, 1024); }
+
+void showClock() {
+    root.addModal(Alert::make().message(
+        // prettyValue(driver->currentFlash(), "B", 1, 1024) + "/" + prettyValue(driver->maxFlash(), "B", 1, 1024)
+        prettyValue(driver->currentClock(), "Hz") + "/" + prettyValue(driver->maxClock(), "Hz")
+    ).buildPtr());
+}
+
+void showLatency() {
+    char txt[48];
+    snprintf(txt, sizeof(txt), "Key>px %u/%u/%ums Frame %lums",
+             frames.latencyPercentile(50), frames.latencyPercentile(90), frames.latencyPercentile(99),
+             (unsigned long)frames.frameCost());
+    root.addModal(Alert::make().message(txt).buildPtr());
+}
+
+void wipeSettings() {
+    root.addModal(ConfirmModal::make().message("Are you sure?").onConfirm([] {
+        settings.wipe();
+        driver->reboot();
+    }).buildPtr());
+}
+
+constexpr MenuEntry radio_entries[] = {
+    MenuEntry::number('\x90', "Freq", &settings.data.radio_frequency, BAND_START, BAND_END, 3, 3, "mHz"),
+    MenuEntry::select('\x1D', "Bandw", &settings.data.radio_bandwidth, bandwidth_names),
+    MenuEntry::number('\x12', "SF", &settings.data.radio_sf, 5, 12),
+    MenuEntry::number('\xAF', "CR", &settings.data.radio_cr, 5, 8),
+    MenuEntry::number('\x8C', "Power", &settings.data.radio_power, -9, 22, "dBm"),
+    MenuEntry::select('x', "Band", &settings.data.radio_band, band_names),
+};
+constexpr MenuTable radio_menu = MenuTable::of('\xAD', "Radio", radio_entries, [] {
+    settings.save();
+    postRadio(applyRadio);
+});
+
+constexpr MenuEntry network_entries[] = {
+    MenuEntry::select(0x00, "Mode", &settings.data.net_mode, net_mode_names),
+    MenuEntry::number(0x00, "Slots", &settings.data.tdma_slots, 2, 32),
+    MenuEntry::number(0x00, "Own slot", &settings.data.tdma_slot, 0, 31),
+    MenuEntry::toggle(0x00, "Hopping", &settings.data.net_hopping),
+    MenuEntry::textField(0x00, "Key", settings.data.net_key, 15),
+};
+constexpr MenuTable network_menu = MenuTable::of('\x1D', "Network", network_entries, [] {
+    settings.save();
+    postRadio(configureNetwork);
+});
+
+constexpr MenuEntry display_entries[] = {
 #ifdef HAS_CONTRAST
-                NumberPicker<uint8_t>::make().title("Contrast").pointer(&settings.data.display_contrast).buildPtr(),
+    MenuEntry::number(0x00, "Contrast", &settings.data.display_contrast, 0, 255),
 #endif
 #ifdef HAS_BACKLIGHT
-                NumberPicker<uint8_t>::make().title("Backlight").pointer(&settings.data.display_backlight).buildPtr(),
+    MenuEntry::number(0x00, "Backlight", &settings.data.display_backlight, 0, 255),
+#endif
+    MenuEntry::number(0x00, "Rotation", &settings.data.display_rotation, 0, 3),
+    MenuEntry::toggle(0x00, "Inverted", &settings.data.display_inverted),
+    MenuEntry::toggle(0x00, "Icons", &settings.data.display_icons),
+    MenuEntry::toggle(0x00, "Alert inv", &settings.data.display_inv_alert),
+};
+constexpr MenuTable display_menu = MenuTable::of('\x95', "Display", display_entries, [] {
+    settings.save();
+    settings.applyDisplay(display);
+    // display.display();
+});
+
+constexpr MenuEntry device_entries[] = {
+    MenuEntry::textField(0x00, "Name", settings.data.device_name, 15),
+};
+constexpr MenuTable device_menu = MenuTable::of('\x91', "Device", device_entries, [] {
+    settings.save();
+});
+
+constexpr MenuEntry settings_entries[] = {
+    MenuEntry::menu(radio_menu),
+    MenuEntry::menu(network_menu),
+    MenuEntry::menu(display_menu),
+    MenuEntry::menu(device_menu),
+};
+constexpr MenuTable settings_menu = MenuTable::of('\x8D', "Settings", settings_entries);
+
+#ifdef ENABLE_PROBES
+constexpr MenuEntry probe_entries[] = {
+    MenuEntry::element(0x00, "Probes", []() -> UIElement* { return ProbeView::make().buildPtr(); }),
+    MenuEntry::button(0x00, "Dump serial", [] {
+        char line[64];
+        Serial.println("probe count avg/min/max");
+        for (ProbeSite* s = ProbeSite::first(); s; s = s->next()) {
+            s->format(line, sizeof(line));
+            Serial.println(line);
+        }
+    }),
+};
+constexpr MenuTable probe_menu = MenuTable::of(0x00, "Probes", probe_entries);
 #endif
-                NumberPicker<uint8_t>::make().title("Rotation").pointer(&settings.data.display_rotation).min(0).max(3).buildPtr(),
-                Toggle::make().title("Inverted").pointer(&settings.data.display_inverted).buildPtr(),
-                Toggle::make().title("Icons").pointer(&settings.data.display_icons).buildPtr(),
-                Toggle::make().title("Alert inv").pointer(&settings.data.display_inv_alert).buildPtr()
-            }).onExit([] {
-                settings.save();
-                settings.applyDisplay(display);
-                // display.display();
-            }).buildPtr(),
-            MenuView::make().icon('\x91').title("Device").children({
-                TextField::make().title("Name").pointer(settings.data.device_name).maxLength(15).buildPtr(),
-            }).onExit([] {
-                settings.save();
-            }).buildPtr(),
-        }).buildPtr(),
 
-        MenuView::make().icon('*').title("Tools").children({
-            BandScanner::make().radio(&radio).buildPtr(),
-        }).buildPtr(),
+constexpr MenuEntry dynamic_hw_entries[] = {
+    MenuEntry::button(0x00, "Clock", showClock),
+    MenuEntry::button(0x00, "Latency", showLatency),
+    MenuEntry::element(0x00, "Boot", []() -> UIElement* { return BootView::make().log(&boot).buildPtr(); }),
+};
+constexpr MenuTable dynamic_hw_menu = MenuTable::of(0x00, "Dynamic HW", dynamic_hw_entries);
+
+constexpr MenuEntry settings_dump_entries[] = {
+    MenuEntry::value("Freq", &settings.data.radio_frequency, "%.3fmHz"),
+    MenuEntry::value("Bandw", &settings.data.radio_bandwidth, bandwidth_names),
+    MenuEntry::value("SF", &settings.data.radio_sf, "%d"),
+    MenuEntry::value("CR", &settings.data.radio_cr, "%d"),
+    MenuEntry::value("Power", &settings.data.radio_power, "%ddBm"),
+    MenuEntry::value("Band", &settings.data.radio_band, band_names),
+    MenuEntry::label("===="),
+#ifdef HAS_CONTRAST
+    MenuEntry::value("Contrast", &settings.data.display_contrast, "%d"),
+#endif
+#ifdef HAS_BACKLIGHT
+    MenuEntry::value("Backlight", &settings.data.display_backlight, "%d"),
+#endif
+    MenuEntry::value("Rotation", &settings.data.display_rotation, "%d"),
+    MenuEntry::value("Inverted", &settings.data.display_inverted, "%d"),
+    MenuEntry::label("===="),
+    MenuEntry::value("Name", settings.data.device_name, "%s"),
+    MenuEntry::label("===="),
+    MenuEntry::value("MCU", hwMcu),
+    MenuEntry::value("Clock", hwClock),
+    MenuEntry::value("RAM", hwRam),
+    MenuEntry::value("Flash", hwFlash),
+    MenuEntry::label("===="),
+    MenuEntry::button(0x00, "Clock", showClock),
+    MenuEntry::element(0x00, "Memory", []() -> UIElement* { return MemoryView::make().buildPtr(); }),
+};
+constexpr MenuTable settings_dump_menu = MenuTable::of(0x00, "Settings", settings_dump_entries);
+
+#ifdef ENABLE_ALLOC_TRACKING
+constexpr MenuEntry alloc_entries[] = {
+    MenuEntry::element(0x00, "Allocs", []() -> UIElement* { return AllocView::make().buildPtr(); }),
+    MenuEntry::button(0x00, "Dump serial", [] {
+        char line[64];
+        for (uint8_t t = 0; t < static_cast<uint8_t>(AllocTag::COUNT); t++) {
+            const AllocStats& s = AllocTracker::stats(static_cast<AllocTag>(t));
+            snprintf(line, sizeof(line), "%s scopes %lu allocs %lu bytes %lu worst %lu peak %lu over %lu",
+                     AllocTracker::tagName(static_cast<AllocTag>(t)), (unsigned long)s.scopes,
+                     (unsigned long)s.allocs, (unsigned long)s.bytes, (unsigned long)s.worst,
+                     (unsigned long)s.peak, (unsigned long)s.overruns);
+            Serial.println(line);
+        }
+        AllocSite top[ALLOC_SITES];
+        uint8_t n = AllocTracker::topSites(top, ALLOC_SITES);
+        for (uint8_t i = 0; i < n; i++) {
+            snprintf(line, sizeof(line), "0x%08lX x%lu %luB", (unsigned long)top[i].addr,
+                     (unsigned long)top[i].count, (unsigned long)top[i].bytes);
+            Serial.println(line);
+        }
+    }),
+};
+constexpr MenuTable alloc_menu = MenuTable::of(0x00, "Allocs", alloc_entries);
+#endif
 
-        MenuView::make().icon('\x91').title("Debug").children({
+constexpr MenuEntry debug_entries[] = {
 #ifdef HAS_COLOR
-            ColorInput<uint16_t>::make().pointer(&ui_context.theme.fg).title("Foreground").buildPtr(),
-            ColorInput<uint16_t>::make().pointer(&ui_context.theme.bg).title("Background").buildPtr(),
+    MenuEntry::element(0x00, "Foreground", []() -> UIElement* {
+        return ColorInput<uint16_t>::make().pointer(&ui_context.theme.fg).title("Foreground").buildPtr();
+    }),
+    MenuEntry::element(0x00, "Background", []() -> UIElement* {
+        return ColorInput<uint16_t>::make().pointer(&ui_context.theme.bg).title("Background").buildPtr();
+    }),
 #endif
-            CharTable::make().buildPtr(),
-            SizeDemo::make().buildPtr(),
-            MenuView::make().title("Dynamic HW").children({
-                Button::make().title("Clock").onClick([] {
-                    root.addModal(Alert::make().message(
-                        // prettyValue(driver->currentFlash(), "B", 1, 1024) + "/" + prettyValue(driver->maxFlash(), "B", 1, 1024)
-                        prettyValue(driver->currentClock(), "Hz") + "/" + prettyValue(driver->maxClock(), "Hz")
-                    ).buildPtr());
-                }).buildPtr(),
-            }).buildPtr(),
-            MenuView::make().title("Settings").children({
-                Property<float>::make().title("Freq").pointer(&settings.data.radio_frequency).fmt("%.3fmHz").buildPtr(),
-                Property<uint8_t>::make().title("Bandw").pointer(&settings.data.radio_bandwidth).values(bandwidths).buildPtr(),
-                Property<uint8_t>::make().title("SF").pointer(&settings.data.radio_sf).fmt("%d").buildPtr(),
-                Property<uint8_t>::make().title("CR").pointer(&settings.data.radio_cr).fmt("%d").buildPtr(),
-                Property<int8_t>::make().title("Power").pointer(&settings.data.radio_power).fmt("%ddBm").buildPtr(),
-                Property<uint8_t>::make().title("Band").pointer(&settings.data.radio_band).values(bands).buildPtr(),
-                Label::make().title("====").buildPtr(),
-#ifdef HAS_CONTRAST
-                Property<uint8_t>::make().title("Contrast").pointer(&settings.data.display_contrast).fmt("%d").buildPtr(),
+    MenuEntry::element(0x00, "Chars", []() -> UIElement* { return CharTable::make().buildPtr(); }),
+    MenuEntry::element(0x00, "Sizes", []() -> UIElement* { return SizeDemo::make().buildPtr(); }),
+#ifdef ENABLE_PROBES
+    MenuEntry::menu(probe_menu),
 #endif
-#ifdef HAS_BACKLIGHT
-                Property<uint8_t>::make().title("Backlight").pointer(&settings.data.display_backlight).fmt("%d").buildPtr(),
+    MenuEntry::menu(dynamic_hw_menu),
+    MenuEntry::menu(settings_dump_menu),
+#ifdef ENABLE_ALLOC_TRACKING
+    MenuEntry::menu(alloc_menu),
 #endif
-                Property<uint8_t>::make().title("Rotation").pointer(&settings.data.display_rotation).fmt("%d").buildPtr(),
-                Property<bool>::make().title("Inverted").pointer(&settings.data.display_inverted).fmt("%d").buildPtr(),
-                Label::make().title("====").buildPtr(),
-                StringProperty::make().title("Name").pointer(settings.data.device_name).buildPtr(),
-                Label::make().title("====").buildPtr(),
-                Label::make().title(String("MCU:   ") + HW_MCU).buildPtr(),
-                Label::make().title(String("Clock: ") + prettyValue(HW_F_CPU,"Hz",0,1000)).buildPtr(),
-                Label::make().title(String("RAM:   ") + prettyValue(HW_RAM_BYTES,"B",0,1024)).buildPtr(),
-                Label::make().title(String("Flash: ") + prettyValue(HW_FLASH_BYTES,"B",0,1024)).buildPtr(),
-                Label::make().title("====").buildPtr(),
-                Button::make().title("Clock").onClick([] {
-                    root.addModal(Alert::make().message(
-                        // prettyValue(driver->currentFlash(), "B", 1, 1024) + "/" + prettyValue(driver->maxFlash(), "B", 1, 1024)
-                        prettyValue(driver->currentClock(), "Hz") + "/" + prettyValue(driver->maxClock(), "Hz")
-                    ).buildPtr());
-                }).buildPtr(),
-                Button::make().title("RAM").onClick([] {
-                    root.addModal(Alert::make().message(
-                        // prettyValue(driver->currentFlash(), "B", 1, 1024) + "/" + prettyValue(driver->maxFlash(), "B", 1, 1024)
-                        prettyValue(driver->currentRam(), "B", 0, 1024) + "/" + prettyValue(driver->maxRam(), "B", 0, 1024)
-                    ).buildPtr());
-                }).buildPtr(),
-            }).buildPtr(),
 #ifdef HAS_COLOR
-            ColorWheel::make().buildPtr(),
+    MenuEntry::element(0x00, "Colors", []() -> UIElement* { return ColorWheel::make().buildPtr(); }),
 #endif
-            Button::make().title("Wipe EEPROM").onClick([] {
-                root.addModal(ConfirmModal::make().message("Are you sure?").onConfirm([] {
-                    settings.wipe();
-                    driver->reboot();
-                }).buildPtr());
-            }).buildPtr()
+    MenuEntry::button(0x00, "Wipe EEPROM", wipeSettings),
+};
+constexpr MenuTable debug_menu = MenuTable::of('\x91', "Debug", debug_entries);
+
+constexpr MenuEntry hw_entries[] = {
+    MenuEntry::value("MCU", hwMcu),
+    MenuEntry::value("Clock", hwClock),
+    MenuEntry::value("RAM", hwRam),
+    MenuEntry::value("Flash", hwFlash),
+};
+constexpr MenuTable hw_menu = MenuTable::of(0x00, "Device", hw_entries);
+
+constexpr MenuEntry libs_entries[] = {
+    MenuEntry::label("Work in progress"),
+};
+constexpr MenuTable libs_menu = MenuTable::of(0x00, "Libs", libs_entries);
+
+constexpr MenuEntry info_entries[] = {
+    MenuEntry::menu(hw_menu),
+    MenuEntry::menu(libs_menu),
+};
+constexpr MenuTable info_menu = MenuTable::of('i', "Info", info_entries);
+
+
+UIElement* buildMenu() { // in setup() rather than at static init, so it runs while the radio starts
+    message_menu = MenuView::make().fill(FillMode::TOP).rows(messageCount, [](UIContext& ctx, uint16_t i) {
+        UIElement::printLabel(ctx, '\xBD', loggedMessage(i), ctx.availableCharsX());
+        ctx.println();
+    }).buildPtr();
+    return MenuView::make().title("Radio").children({
+        TabSelector::make().icon('\x8C').title("Broadcast").children({
+            TextField::make().title(">").spacer(false).maxLength(MESSAGE_LENGTH-1).onSubmit([](char* buf) {
+                if (!strlen(buf)) return;
+                sendMessage(buf, true);
+            }).buildPtr(),
+            message_menu
+        }).buildPtr(),
+
+        StaticMenu::make().table(settings_menu).buildPtr(),
+
+        LazyView::make().icon('*').title("Tools").keep().factory([]() -> UIElement* {
+            return MenuView::make().icon('*').title("Tools").children({
+                BandScanner::make().radio(&radio).sweeper([](BandScanner* scanner) {
+                    return postRadio([scanner]() -> int16_t {
+                        scanner->sweep();
+                        return RADIOLIB_ERR_NONE;
+                    }, [scanner](int16_t) { scanner->finish(); });
+                }).retune([] { netman.retune(); }).buildPtr(),
+            }).buildPtr();
         }).buildPtr(),
 
+        StaticMenu::make().table(debug_menu).buildPtr(),
+
         MenuView::make().icon('\x93').title("Power").buildPtr(),
 
-        MenuView::make().icon('i').title("Info").children({
-            MenuView::make().title("Device").children({
-                Label::make().title(String("MCU:   ") + HW_MCU).buildPtr(),
-                Label::make().title(String("Clock: ") + prettyValue(HW_F_CPU,"Hz",0,1000)).buildPtr(),
-                Label::make().title(String("RAM:   ") + prettyValue(HW_RAM_BYTES,"B",0,1024)).buildPtr(),
-                Label::make().title(String("Flash: ") + prettyValue(HW_FLASH_BYTES,"B",0,1024)).buildPtr()
-            }).buildPtr(),
-            MenuView::make().title("Libs").children({
-                Label::make().title("Work in progress").buildPtr()
-            }).buildPtr()
-        }).buildPtr()
-    }).buildPtr()
-).build();
+        StaticMenu::make().table(info_menu).buildPtr()
+    }).buildPtr();
+}
+
+
+void requestFrame();
+
+void renderFrame() {
+    ALLOC_SCOPE(AllocTag::RENDER);
+    frame_timer = EVENT_NO_TIMER;
+    uint32_t now = millis();
+    frames.begin(now);
+    ui_context.render(root);
+    if (!first_frame) {
+        first_frame = true;
+        boot.mark("frame", micros());
+    }
+    if (ui_context.animating()) frames.animate(now + ui_context.animationDelay());
+    frames.end(millis());
+    requestFrame(); // next animation frame, if any
+}
+
+void requestFrame() {
+    if (ui_context.refreshRequested()) frames.request();
+
+    events.cancel(frame_timer);
+    frame_timer = EVENT_NO_TIMER;
+
+    uint32_t wait = frames.untilFrame(millis());
+    if (wait != FRAME_NONE) frame_timer = events.after(wait, renderFrame);
+}
+
+void messageSent(const char* text, int16_t status) {
+    if (status == RADIOLIB_ERR_NONE) {
+        char* slot = message_log[messages_logged++ % MESSAGE_HISTORY];
+        strncpy(slot, text, MESSAGE_LOG_LENGTH - 1);
+        slot[MESSAGE_LOG_LENGTH - 1] = '\0';
+        message_menu->scrollToEnd();
+    } else if (status == RADIOLIB_LORA_DETECTED) { // maybe remove detection at all?
+        strncpy(pending_message, text, sizeof(pending_message) - 1);
+        root.addModal(ConfirmModal::make().message("Busy channel" + String(status)).onConfirm([] {
+            sendMessage(pending_message, false);
+        }).buildPtr());
+    } else {
+        root.addModal(Alert::make().message("Err: " + String(status)).buildPtr());
+    }
+    ui_context.refresh();
+}
+
+void sendMessage(const char* text, bool sense) {
+    LinkFrame f;
+    f.op = LinkOp::SEND;
+    f.flag = sense;
+    f.assign(text, strlen(text));
+    if (!toRadio(f)) messageSent(text, NET_ERR_QUEUE_FULL);
+}
+
+void pollKeyboard() {
+    uint32_t now = millis();
+    if (keyboard.read(now)) events.post(EventType::KEY);
+    // one periodic slot held for good; until a full timer table frees one, serviceUi() polls
+    uint32_t interval = keyboard.pollInterval(now);
+    if (events.scheduled(keyboard_timer)) events.reschedule(keyboard_timer, interval);
+    else keyboard_timer = events.every(interval, pollKeyboard);
+    keyboard_due = now + interval;
+}
+
+void handleKeys() {
+    ALLOC_SCOPE(AllocTag::KEYS);
+    if (keyboard.interruptDriven()) keyboard.read(millis());
+
+    bool changed = false;
+    KeyEvent key;
+    while (keyboard.pop(key)) { // all queued keys, then a single frame
+        if (key.key == KEY_FN_C) driver->reboot();
+        if (root.update(ui_context, key.key)) {
+            frames.input(key.time);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        ui_context.refresh();
+        requestFrame();
+    }
+}
+
+void handleUiFrame(LinkFrame& f) {
+    switch (f.op) {
+        case LinkOp::RECEIVED: {
+            ALLOC_SCOPE(AllocTag::RX);
+            Packet* packet = Packet::parse(f.data, f.len);
+            if (packet) netman.dispatch(*packet);
+            delete packet;
+            requestFrame();
+            break;
+        }
+        case LinkOp::SENT: {
+            ALLOC_SCOPE(AllocTag::TX);
+            char text[LINK_FRAME_MAX + 1];
+            memcpy(text, f.data, f.len);
+            text[f.len] = '\0';
+            messageSent(text, f.status);
+            requestFrame();
+            break;
+        }
+        case LinkOp::REPLY:
+            f.done(f.status);
+            break;
+        default:
+            break;
+    }
+}
+
+void reportBoot() {
+    char line[40];
+    for (uint8_t i = 0; i < boot.stages(); i++) {
+        snprintf(line, sizeof(line), "boot %-8s +%lums @%lums", boot.name(i),
+                 (unsigned long)(boot.took(i) / 1000), (unsigned long)(boot.at(i) / 1000));
+        Serial.println(line);
+    }
+}
+
+void radioAlert(const char* what, int16_t status) {
+    root.addModal(Alert::make().message(String(what) + " ERROR " + String(status)).buildPtr());
+    ui_context.refresh();
+    requestFrame();
+}
+
+void startRadio() {
+    postRadio(beginRadio, [](int16_t state) {
+        boot.mark("radio", micros());
+        if (state != RADIOLIB_ERR_NONE) {
+            radioAlert("Radio", state);
+            reportBoot();
+            return;
+        }
+
+        postRadio(sendHello, [](int16_t res) { // the first beacon goes out in the background
+            boot.mark("beacon", micros());
+            if (res != RADIOLIB_ERR_NONE) radioAlert("Beacon", res);
+            reportBoot();
+        });
+    });
+}
+
+void serviceUi() {
+#ifdef DUAL_CORE
+    LinkFrame f;
+    while (core_link.fromRadio(f)) handleUiFrame(f);
+#endif
+#ifdef DISPLAY_ASYNC_FLUSH
+    display.busy(); // hands the display bus back as soon as the frame is out
+#endif
+    if (keyboard_timer == EVENT_NO_TIMER && !keyboard.interruptDriven()
+        && static_cast<int32_t>(millis() - keyboard_due) >= 0) pollKeyboard();
+}
 
 
 void setup() {
+    driver->paintStack();
     driver->init();
+    probeBegin();
+#ifdef ENABLE_ALLOC_TRACKING
+    AllocTracker::budget(AllocTag::RENDER, ALLOC_BUDGET_RENDER);
+    AllocTracker::budget(AllocTag::KEYS, ALLOC_BUDGET_KEYS);
+    AllocTracker::onOverBudget([](AllocTag tag, uint32_t allocs) {
+        Serial.print("alloc budget: ");
+        Serial.print(AllocTracker::tagName(tag));
+        Serial.print(' ');
+        Serial.println(allocs);
+    });
+#endif
     Serial.begin(115200);
+    boot.mark("init", micros());
 
     bool settings_reset = settings.begin();
+    boot.mark("settings", micros());
+
+#ifdef DUAL_CORE
+    startRadioCore(setup1, loop1); // arduino-pico is already running them on core1
+    startRadio(); // core1 brings the radio up while the display starts
+#else
+    setupRadio();
+#endif
 
 #ifdef TARGET_SH1106
     display.begin(DISPLAY_ADDRESS, true);
@@ -229,102 +702,57 @@ void setup() {
     ui_context.display.cp437();
     settings.applyDisplay(display);
     ui_context.reset();
+    boot.mark("display", micros());
 
-#if DISPLAY_MODE == DISPLAY_MODE_EINK // simple output mode for e-in
-    display.setPartialWindow(0, 0, 200, 200);
-    display.firstPage();
-#endif
-
-    if (settings_reset) ui_context.println("Settings reset...");
-    ui_context.print("Radio...");
-    // ui_context.println(prettyValue(SystemCoreClock, "Hz"));
-    ui_context.flush();
-
-    int state = radio.begin(settings.data.radio_frequency, bandwidths_float[settings.data.radio_bandwidth],
-                            settings.data.radio_sf, settings.data.radio_cr,
-                            RADIOLIB_SX126X_SYNC_WORD_PRIVATE,
-                            settings.data.radio_power,
-                            8, 1.6, false);
-    radio.setCurrentLimit(60.0);
-    radio.setDio2AsRfSwitch(true);
-    radio.explicitHeader();
-    radio.setCRC(1);
-    radio.setDio1Action(setFlag);
-    radio.startReceive();
-
-    if (state == RADIOLIB_ERR_NONE) {
-        ui_context.println("OK");
-        ui_context.flush();
-    } else {
-        ui_context.printf("ERROR %i", state);
-        ui_context.flush();
-        while (true) {}
-    }
-
-    ui_context.print("Events...");
-    ui_context.flush();
-    netman.begin(&radio, &enable_interrupt);
+    root.setRoot(buildMenu());
     netman.reg<HelloPacket>([](const auto& packet) {
         char txt[11];
         snprintf(txt, sizeof(txt), "0x%08lX", (unsigned long)(packet.hwid()));
         root.addModal(Alert::make().message(txt).buildPtr());
     });
-    ui_context.println("OK");
-    ui_context.flush();
-
-    ui_context.print("Beacon...");
-    ui_context.flush();
-    HelloPacket packet;
-    packet.hwid(driver->boardId());
-    int16_t res = netman.send(packet);
-    if (res != RADIOLIB_ERR_NONE) {
-        ui_context.printf("ERROR %i", res);
-        ui_context.flush();
-        while (true) {}
-    }
-    ui_context.println("OK");
+    if (settings_reset) root.addModal(Alert::make().message("Settings reset").buildPtr());
+    boot.mark("ui", micros());
 
-    ui_context.println("Loaded!");
-    ui_context.flush();
-    delay(1000);
+    events.on(EventType::KEY, [](const Event&) {
+        handleKeys();
+    });
+    events.on(EventType::REFRESH, [](const Event&) {
+        requestFrame();
+    });
+    keyboard.begin(extI2C, KEYBOARD_ADDRESS, KEYBOARD_INT, keyboardIrq);
+    if (!keyboard.interruptDriven()) pollKeyboard();
 
     ui_context.refresh(true);
+    requestFrame();
+#ifndef DUAL_CORE
+    events.after(0, startRadio); // queued behind the first frame
+#endif
 }
 
 
 void loop() {
-    extI2C->requestFrom(KEYBOARD_ADDRESS, 1);
-    while (extI2C->available()) {
-        char c = extI2C->read();
-        if (c == 0) continue;
-        if (c == KEY_FN_C) driver->reboot();
-        if (root.update(ui_context, c)) ui_context.refresh();
-    }
+    serviceUi();
+    events.run();
+}
 
-    if (received_flag) {
-        enable_interrupt = false;
-        received_flag = false;
-
-        uint8_t len = radio.getPacketLength();
-        uint8_t* data = new uint8_t[len];
-        radio.readData(data, 0);
-        ReadBuffer buffer = ReadBuffer(data, len);
-        uint8_t packet_type = buffer.u8();
-        Packet* packet = Packet::create(packet_type);
-        if (packet) {
-            packet->deserialize(buffer);
-            netman.dispatch(*packet);
-        }
-        radio.startReceive();
-        enable_interrupt = true;
 
-        delete packet;
-        delete[] data;
-    }
+// Radio side; on single-core builds it shares loop() and the event loop with the UI
+void setupRadio() {
+    radio_events.on(EventType::RADIO, [](const Event&) {
+        receivePacket();
+        scheduleNet(); // beacons move the slot schedule
+    });
+}
 
-    uint32_t frame_interval = 1000 / DISPLAY_FPS;
-    if (millis() - last_update > frame_interval && ui_context.refreshRequested()) {
-        ui_context.render(root);
-        last_update += frame_interval;
-    }
+#ifdef DUAL_CORE
+void setup1() {
+    driver->paintStack();
+    setupRadio();
 }
+
+void loop1() {
+    LinkFrame f;
+    while (core_link.fromUi(f)) handleRadioFrame(f);
+    radio_events.run();
+}
+#endif
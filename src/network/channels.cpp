@@ -0,0 +1,83 @@
+#include "network/channels.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace {
+    uint32_t xorshift32(uint32_t& s) {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+
+    uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        while (len--) h = (h ^ *p++) * 16777619u;
+        return h;
+    }
+}
+
+void ChannelPlan::configure(float band_start, float band_end, float bandwidth_khz, float control, uint32_t seed) {
+    spacing = bandwidth_khz * 1.6f / 1000.0f;
+    float n = std::floor((band_end - band_start) / spacing);
+    count = n > CHANNEL_MAX ? CHANNEL_MAX : static_cast<uint8_t>(n);
+    start = band_start;
+    busy = 0;
+    next = 0;
+    reserved = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        sequence[i] = i;
+        occupancy[i] = 0;
+        if (std::fabs(frequency(i) - control) < spacing) reserved |= 1UL << i;
+    }
+
+    uint32_t state = seed ? seed : 0x9E3779B9;
+    for (uint8_t i = count; i > 1; i--) {
+        uint8_t j = xorshift32(state) % i;
+        uint8_t t = sequence[i-1];
+        sequence[i-1] = sequence[j];
+        sequence[j] = t;
+    }
+
+    // the channel count alone matches for most keys; the sequence and grid tell plans apart
+    uint32_t h = fnv1a(2166136261u, &start, sizeof(start));
+    h = fnv1a(h, &spacing, sizeof(spacing));
+    h = fnv1a(h, sequence, count);
+    signature = h ? h : 1;
+}
+
+void ChannelPlan::adopt(uint32_t coordinator_id, uint32_t mask) {
+    busy = coordinator_id == signature ? mask : 0xFFFFFFFF;
+}
+
+uint8_t ChannelPlan::hop(uint32_t frame) const {
+    if (!count) return CHANNEL_NONE;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t ch = sequence[(frame + i) % count];
+        if (usable(ch)) return ch;
+    }
+    return CHANNEL_NONE;
+}
+
+void ChannelPlan::sample(uint8_t ch, bool detected) {
+    if (ch >= count) return;
+    occupancy[ch] += CHANNEL_ALPHA * ((detected ? 1.0f : 0.0f) - occupancy[ch]);
+}
+
+void ChannelPlan::updateMask() {
+    // skip the busiest channels, but never more than half of the band
+    uint32_t mask = 0;
+    for (uint8_t n = 0; n < count / 2; n++) {
+        int16_t worst = -1;
+        for (uint8_t i = 0; i < count; i++) {
+            if ((mask | reserved) >> i & 1 || occupancy[i] <= CHANNEL_BUSY) continue;
+            if (worst < 0 || occupancy[i] > occupancy[worst]) worst = i;
+        }
+        if (worst < 0) break;
+        mask |= 1UL << worst;
+    }
+    next = mask; // nodes only learn it from the next beacon, so hop() keeps the announced one
+}
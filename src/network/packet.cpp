@@ -0,0 +1,207 @@
+#include "network/packet.h"
+#include "network/packet_types.h"
+#include "probe.h"
+
+/********************/
+/**** NetManager ****/
+/********************/
+int16_t NetManager::transmit(const uint8_t* data, size_t len) {
+    if (!radio || !irq_en) { return RADIOLIB_ERR_NULL_POINTER; }
+
+    *irq_en = false;
+    int16_t status = radio->transmit(data, len);
+    *irq_en = true;
+    radio->startReceive();
+    return status;
+}
+
+void NetManager::configure(NetMode m, uint8_t slots, uint8_t slot, uint32_t id, size_t max_frame) {
+    mode = m;
+    hwid = id;
+    fixed_slot = slot;
+    clock.reset();
+
+    if (mode == NetMode::ALOHA || !radio) return;
+
+    uint32_t slot_us = TdmaSchedule::slotLength(radio->getTimeOnAir(max_frame));
+    schedule.configure(slots, slot_us);
+    schedule.assign(slot && slot < slots ? slot : TdmaSchedule::autoSlot(hwid, slots));
+    next_beacon = micros();
+}
+
+void NetManager::configureHopping(bool enable, float start, float end, float bandwidth_khz, float control_freq, uint32_t seed) {
+    control = control_freq;
+    tuned = control_freq;
+    if (enable && slotted()) plan.configure(start, end, bandwidth_khz, control_freq, seed);
+    else                     plan.clear();
+}
+
+int16_t NetManager::send(Packet& packet) {
+    WriteBuffer buffer = WriteBuffer(packet.size()+1);
+    packet.serialize(buffer);
+    return send(buffer.raw(), buffer.len());
+}
+
+int16_t NetManager::send(const uint8_t* data, size_t len) {
+    if (!slotted()) return transmit(data, len);
+
+    if (tx_queue.size() >= NET_QUEUE_SIZE) return NET_ERR_QUEUE_FULL;
+    tx_queue.emplace_back(data, data + len);
+    return RADIOLIB_ERR_NONE;
+}
+
+void NetManager::sendBeacon(uint32_t now) {
+    BeaconPacket beacon;
+    beacon.hwid(hwid);
+    beacon.seq(++beacon_seq);
+    beacon.frameStart(now);
+    beacon.prevDone(beacon_done);
+    beacon.slots(schedule.slotCount());
+    beacon.slotUs(schedule.slotUs());
+    beacon.channels(plan.channels());
+    beacon.plan(plan.id());
+    beacon.busyMask(plan.announce());
+
+    WriteBuffer buffer = WriteBuffer(beacon.size()+1);
+    beacon.serialize(buffer);
+    if (transmit(buffer.raw(), buffer.len()) == RADIOLIB_ERR_NONE) {
+        beacon_done = irq_time ? *irq_time : micros();
+    }
+}
+
+void NetManager::onBeacon(BeaconPacket& beacon, uint32_t at) {
+    if (mode != NetMode::TDMA_NODE || beacon.slots() < 2 || !beacon.slotUs()) return;
+
+    clock.precise(beacon.seq(), at, beacon.seq() - 1, beacon.prevDone());
+    clock.coarse(at, beacon.frameStart() + radio->getTimeOnAir(beacon.size()+1));
+
+    if (beacon.slots() != schedule.slotCount() || beacon.slotUs() != schedule.slotUs()) {
+        schedule.configure(beacon.slots(), beacon.slotUs());
+        schedule.assign(fixed_slot && fixed_slot < beacon.slots() ? fixed_slot : TdmaSchedule::autoSlot(hwid, beacon.slots()));
+    }
+    schedule.anchor(beacon.frameStart(), beacon.seq());
+    last_beacon = at;
+
+    // a coordinator with another key/bandwidth would put us on the wrong channels
+    plan.adopt(beacon.plan(), beacon.busyMask());
+}
+
+void NetManager::retune(uint32_t network, uint32_t guard) {
+    float freq = control;
+    if (plan.channels() && synced() && !schedule.inBeaconWindow(network, guard)) {
+        uint8_t ch = plan.hop(schedule.frameIndex(network));
+        if (ch != CHANNEL_NONE) freq = plan.frequency(ch);
+    }
+
+    if (freq == tuned) return;
+    radio->setFrequency(freq);
+    radio->startReceive();
+    tuned = freq;
+}
+
+void NetManager::retune() {
+    if (!radio) return;
+
+    uint32_t now = micros();
+    bool coordinator = mode == NetMode::TDMA_COORDINATOR;
+    tuned = 0; // whatever it is on now
+    retune(coordinator ? now : clock.toNetwork(now),
+           TdmaSchedule::guardTime(0, coordinator ? TDMA_JITTER_US : clock.uncertainty(now)));
+}
+
+void NetManager::sampleChannel() {
+    // one CAD per frame, right after the beacon while the rest of slot 0 is idle
+    for (uint8_t i = 0; i < plan.channels(); i++) {
+        uint8_t ch = probe++ % plan.channels();
+        if (!plan.usable(ch) && !(plan.busyMask() >> ch & 1)) continue; // reserved
+
+        *irq_en = false;
+        radio->setFrequency(plan.frequency(ch));
+        plan.sample(ch, radio->scanChannel() == RADIOLIB_LORA_DETECTED);
+        radio->setFrequency(control);
+        *irq_en = true;
+        radio->startReceive();
+        tuned = control;
+
+        plan.updateMask();
+        return;
+    }
+}
+
+void NetManager::tick() {
+    if (!slotted() || !radio) return;
+    PROBE("net tick");
+    uint32_t now = micros();
+
+    if (mode == NetMode::TDMA_COORDINATOR) {
+        if (static_cast<int32_t>(now - next_beacon) >= 0) {
+            retune(now, 0);
+            sendBeacon(now);
+            schedule.anchor(now, beacon_seq);
+            next_beacon = now + schedule.frameUs();
+            if (plan.channels()) sampleChannel();
+        }
+    } else if (clock.synced() && now - last_beacon > TDMA_SYNC_LOSS * schedule.frameUs()) {
+        clock.reset();
+    }
+
+    bool coordinator = mode == NetMode::TDMA_COORDINATOR;
+    uint32_t network = coordinator ? now : clock.toNetwork(now);
+    uint32_t uncertainty = coordinator ? TDMA_JITTER_US : clock.uncertainty(now);
+    retune(network, TdmaSchedule::guardTime(0, uncertainty));
+
+    if (tx_queue.empty()) return;
+    auto& frame = tx_queue.front();
+
+    if (!synced()) { // no coordinator around, fall back to random access
+        transmit(frame.data(), frame.size());
+        tx_queue.erase(tx_queue.begin());
+        return;
+    }
+
+    uint32_t airtime = radio->getTimeOnAir(frame.size());
+    if (schedule.canSend(network, airtime, TdmaSchedule::guardTime(airtime, uncertainty))) {
+        transmit(frame.data(), frame.size());
+        tx_queue.erase(tx_queue.begin());
+    }
+}
+
+uint32_t NetManager::nextTick() const {
+    if (!slotted() || !radio) return NET_IDLE;
+
+    bool coordinator = mode == NetMode::TDMA_COORDINATOR;
+    uint32_t now = micros();
+    uint32_t wait = NET_IDLE;
+
+    if (coordinator) {
+        int32_t left = static_cast<int32_t>(next_beacon - now);
+        wait = left > 0 ? left : 0;
+    } else if (clock.synced()) {
+        int32_t left = static_cast<int32_t>(last_beacon + TDMA_SYNC_LOSS * schedule.frameUs() - now);
+        wait = left > 0 ? left : 0;
+    }
+
+    uint32_t network = coordinator ? now : clock.toNetwork(now);
+    uint32_t uncertainty = coordinator ? TDMA_JITTER_US : clock.uncertainty(now);
+    if (!tx_queue.empty()) {
+        uint32_t airtime = radio->getTimeOnAir(tx_queue.front().size());
+        uint32_t guard = TdmaSchedule::guardTime(airtime, uncertainty);
+        wait = std::min(wait, synced() ? schedule.untilSlot(network, guard) : 0);
+    }
+    if (plan.channels() && synced()) {
+        wait = std::min(wait, schedule.untilWindowEdge(network, TdmaSchedule::guardTime(0, uncertainty)));
+    }
+    return wait;
+}
+
+void NetManager::handle(Packet& p, uint32_t at) {
+    if (p.type() == BeaconPacket::PACKET_TYPE) onBeacon(static_cast<BeaconPacket&>(p), at);
+}
+
+void NetManager::dispatch(Packet& p) {
+    PROBE("dispatch");
+    auto it = listeners.find(p.type());
+    if (it != listeners.end()) {
+        for (auto& f : it->second) f(p);
+    }
+}
@@ -1,5 +1,8 @@
 #include "network/packet_types.h"
 
+/*********************/
+/**** HelloPacket ****/
+/*********************/
 void HelloPacket::serialize(WriteBuffer& buffer) {
     buffer.u8(type());
     buffer.u32(hwid());
@@ -10,9 +13,38 @@ void HelloPacket::deserialize(ReadBuffer& buffer) {
 }
 
 
+/**********************/
+/**** BeaconPacket ****/
+/**********************/
+void BeaconPacket::serialize(WriteBuffer& buffer) {
+    HelloPacket::serialize(buffer);
+    buffer.u16(seq());
+    buffer.u32(frameStart());
+    buffer.u32(prevDone());
+    buffer.u8(slots());
+    buffer.u32(slotUs());
+    buffer.u8(channels());
+    buffer.u32(plan());
+    buffer.u32(busyMask());
+}
+
+void BeaconPacket::deserialize(ReadBuffer& buffer) {
+    HelloPacket::deserialize(buffer);
+    seq(buffer.u16());
+    frameStart(buffer.u32());
+    prevDone(buffer.u32());
+    slots(buffer.u8());
+    slotUs(buffer.u32());
+    channels(buffer.u8());
+    plan(buffer.u32());
+    busyMask(buffer.u32());
+}
+
+
 namespace {
     const bool _registered = [](){
         Packet::registerType(HelloPacket::PACKET_TYPE, [](){ return new HelloPacket(); });
+        Packet::registerType(BeaconPacket::PACKET_TYPE, [](){ return new BeaconPacket(); });
         return true;
     }();
-}
\ No newline at end of file
+}
@@ -0,0 +1,131 @@
+#include "network/tdma.h"
+
+/*******************/
+/**** TdmaClock ****/
+/*******************/
+uint32_t TdmaClock::estimateError(uint32_t baseline) {
+    // both ends of the baseline carry up to TDMA_JITTER_US
+    return TDMA_TRACKED_PPM + static_cast<uint32_t>(2ULL * TDMA_JITTER_US * 1000000 / baseline);
+}
+
+void TdmaClock::reset() {
+    *this = TdmaClock{};
+}
+
+void TdmaClock::coarse(uint32_t local_rx, uint32_t remote_done) {
+    if (samples > 0) return; // two-step samples are always better
+
+    offset = static_cast<int32_t>(remote_done - local_rx);
+    ref_local = local_rx;
+    locked = true;
+}
+
+void TdmaClock::precise(uint16_t seq, uint32_t local_rx, uint16_t beacon_prev_seq, uint32_t remote_prev_done) {
+    if (has_prev && prev_seq == beacon_prev_seq) {
+        int32_t sample = static_cast<int32_t>(remote_prev_done - prev_rx);
+
+        if (samples == 0 || ++window == TDMA_DRIFT_WINDOW) {
+            base_local = samples ? next_local : prev_rx;
+            base_offset = samples ? next_offset : sample;
+            next_local = prev_rx;
+            next_offset = sample;
+            window = 0;
+        }
+
+        // only taken once it beats running free
+        uint32_t baseline = prev_rx - base_local;
+        if (samples >= TDMA_DRIFT_WINDOW && baseline > 0 && estimateError(baseline) < TDMA_FREE_PPM) {
+            drift = static_cast<float>(sample - base_offset) / static_cast<float>(baseline);
+            span = baseline;
+        }
+
+        offset = sample;
+        ref_local = prev_rx;
+        if (samples < 255) samples++;
+        locked = true;
+    }
+
+    prev_rx = local_rx;
+    prev_seq = seq;
+    has_prev = true;
+}
+
+uint32_t TdmaClock::toNetwork(uint32_t local) const {
+    int32_t elapsed = static_cast<int32_t>(local - ref_local);
+    return local + offset + static_cast<int32_t>(drift * static_cast<float>(elapsed));
+}
+
+uint32_t TdmaClock::toLocal(uint32_t network) const {
+    uint32_t guess = network - offset;
+    int32_t elapsed = static_cast<int32_t>(guess - ref_local);
+    return guess - static_cast<int32_t>(drift * static_cast<float>(elapsed));
+}
+
+uint32_t TdmaClock::uncertainty(uint32_t local) const {
+    uint64_t elapsed = local - ref_local;
+    uint64_t ppm = tracking() ? estimateError(span) : TDMA_FREE_PPM;
+    return TDMA_JITTER_US + static_cast<uint32_t>(elapsed * ppm / 1000000);
+}
+
+
+/**********************/
+/**** TdmaSchedule ****/
+/**********************/
+uint32_t TdmaSchedule::guardTime(uint32_t airtime, uint32_t uncertainty) {
+    return airtime / 16 + uncertainty + TDMA_TURNAROUND_US;
+}
+
+uint32_t TdmaSchedule::slotLength(uint32_t max_airtime) {
+    // sized for a freshly synced node; a node drifting further away simply skips its slot
+    return max_airtime + 2 * guardTime(max_airtime, 2 * TDMA_JITTER_US);
+}
+
+uint8_t TdmaSchedule::autoSlot(uint32_t hwid, uint8_t slots) {
+    if (slots < 2) return 0;
+    return 1 + hwid % (slots - 1);
+}
+
+uint32_t TdmaSchedule::position(uint32_t network) const {
+    if (!valid()) return 0;
+    return (network - frame_start) % frameUs();
+}
+
+uint32_t TdmaSchedule::frameIndex(uint32_t network) const {
+    if (!valid()) return frame_seq;
+    return frame_seq + (network - frame_start) / frameUs();
+}
+
+bool TdmaSchedule::inBeaconWindow(uint32_t network, uint32_t guard) const {
+    if (!valid()) return true;
+
+    uint32_t pos = position(network);
+    return pos < slot_us || pos + guard >= frameUs();
+}
+
+bool TdmaSchedule::canSend(uint32_t network, uint32_t airtime, uint32_t guard) const {
+    if (!valid()) return false;
+
+    uint32_t pos = position(network);
+    uint32_t in_slot = pos % slot_us;
+    return pos / slot_us == own_slot
+        && in_slot >= guard
+        && in_slot + airtime + guard <= slot_us;
+}
+
+uint32_t TdmaSchedule::untilSlot(uint32_t network, uint32_t guard) const {
+    if (!valid()) return 0;
+
+    uint32_t pos = position(network);
+    uint32_t target = own_slot * slot_us + guard;
+    return pos <= target ? target - pos : frameUs() - pos + target;
+}
+
+uint32_t TdmaSchedule::untilWindowEdge(uint32_t network, uint32_t guard) const {
+    if (!valid()) return 0;
+
+    uint32_t pos = position(network);
+    uint32_t open = frameUs() - guard; // beacon window opens early by the guard time
+    if (pos < slot_us)  return slot_us - pos;
+    if (pos < open)     return open - pos;
+    return frameUs() - pos + slot_us;
+}
@@ -0,0 +1,53 @@
+#include "probe.h"
+
+#include <cstdio>
+
+/*******************/
+/**** ProbeSite ****/
+/*******************/
+void ProbeSite::link() {
+    linked = true;
+    ProbeSite* h = head.load(std::memory_order_relaxed);
+    do { next_site = h; } while (!head.compare_exchange_weak(h, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void ProbeSite::reset() {
+    hits = 0;
+    min_ticks = UINT32_MAX;
+    max_ticks = 0;
+    total = 0;
+}
+
+#ifdef ENABLE_PROBES
+uint32_t ProbeSite::minUs() const { return hits ? min_ticks / probeTicksPerUs() : 0; }
+uint32_t ProbeSite::avgUs() const { return hits ? static_cast<uint32_t>(total / hits / probeTicksPerUs()) : 0; }
+uint32_t ProbeSite::maxUs() const { return max_ticks / probeTicksPerUs(); }
+#else
+uint32_t ProbeSite::minUs() const { return 0; }
+uint32_t ProbeSite::avgUs() const { return 0; }
+uint32_t ProbeSite::maxUs() const { return 0; }
+#endif
+
+void ProbeSite::resetAll() {
+    for (ProbeSite* s = first(); s; s = s->next()) s->reset();
+}
+
+size_t ProbeSite::format(char* buf, size_t size) const {
+    int n = snprintf(buf, size, "%s %lu %lu/%lu/%luus", site_name, (unsigned long)hits,
+                     (unsigned long)avgUs(), (unsigned long)minUs(), (unsigned long)maxUs());
+    return n < 0 ? 0 : static_cast<size_t>(n);
+}
+
+
+/****************/
+/**** Timers ****/
+/****************/
+#if defined(ENABLE_PROBES) && defined(ARDUINO_ARCH_STM32)
+void probeBegin() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#elif defined(ENABLE_PROBES)
+void probeBegin() {} // free-running timers
+#endif
@@ -1,17 +1,32 @@
+#include <cstring>
+
 #include "ui/base.h"
 #include "configuration.h"
 
-String UIElement::getLabel(int16_t available) const {
-    String label = icon && settings.data.display_icons ? (String(icon) + title) : title;
-    if (available < 0 || available >= label.length()) {
-        // do nothing
-    } else if (available == 0) {
-        label = "";
-    } else if (available < label.length()) {
-        label = label.substring(0, available-1) + '\x96';
+int16_t UIElement::labelLength(char icon, const char* title, int16_t available) {
+    int16_t full = (icon && settings.data.display_icons) + strlen(title);
+    return available < 0 || available >= full ? full : available;
+}
+
+int16_t UIElement::printLabel(UIContext& ctx, char icon, const char* title, int16_t available) {
+    const bool with_icon = icon && settings.data.display_icons;
+    const int16_t length = labelLength(icon, title, available);
+    if (length == 0) return 0;
+
+    const bool cut = length < with_icon + static_cast<int16_t>(strlen(title));
+    int16_t n = cut ? length - 1 : length;
+    if (with_icon && n > 0) {
+        ctx.print(icon);
+        n--;
     }
+    ctx.printn(title, n);
+    if (cut) ctx.print('\x96');
+    return length;
+}
 
-    return label;
+void UIElement::printPrefix(UIContext& ctx, char icon, const char* title, uint8_t value_length) {
+    printLabel(ctx, icon, title, ctx.availableCharsX() - value_length);
+    for (uint8_t i = ctx.availableSpaces(value_length); i > 0; i--) ctx.print(' ');
 }
 
 UIModal* UIApp::eraseFirstModal() {
@@ -30,7 +45,8 @@ UIModal* UIApp::eraseLastModal() {
 }
 
 void UIApp::render(UIContext& ctx) {
-    if (title) ctx.println(title);
+    if (colorized) ctx.println(markup);
+    else if (title) ctx.println(title);
     root->render(ctx, false);
 
     if (last_size != modals.size()) {
@@ -39,11 +55,7 @@ void UIApp::render(UIContext& ctx) {
     }
 
     if (hasModals()) {
-        for (int16_t y = 0; y < ctx.height; y++) {
-            for (int16_t x = 0; x < ctx.width; x++) {
-                if ((x + y) % 2) ctx.display.writePixel(x, y, settings.data.display_inv_alert ? ctx.theme.foreground : ctx.theme.background);
-            }
-        }
+        ctx.shade(settings.data.display_inv_alert ? ctx.theme.foreground : ctx.theme.background);
         ctx.setCursor(0, 0);
         modals.front()->render(ctx);
     }
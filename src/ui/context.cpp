@@ -1,6 +1,9 @@
+#include <algorithm>
+
 #include "ui/context.h"
 #include "configuration.h"
 #include "ui/base.h"
+#include "probe.h"
 
 uint16_t rgb565(uint32_t rgb) {
     uint8_t r = (rgb & 0xFF0000) >> 16;
@@ -11,6 +14,29 @@ uint16_t rgb565(uint32_t rgb) {
 }
 
 
+void UIRect::add(int16_t ax, int16_t ay, int16_t aw, int16_t ah) {
+    if (empty()) {
+        *this = {ax, ay, aw, ah};
+        return;
+    }
+
+    int16_t x1 = std::max<int16_t>(x + w, ax + aw);
+    int16_t y1 = std::max<int16_t>(y + h, ay + ah);
+    x = std::min(x, ax);
+    y = std::min(y, ay);
+    w = x1 - x;
+    h = y1 - y;
+}
+
+
+UIContext::UIContext(DisplayType& display)
+    : display(display), x(0), y(0), width(display.width()), height(display.height()) {
+    // enough cells for either orientation
+    cell_capacity = std::max((width / glyph_width) * (height / glyph_height),
+                             (height / glyph_width) * (width / glyph_height));
+    cells = new TextCell[cell_capacity];
+}
+
 void UIContext::setCursor(const int16_t tx, const int16_t ty) {
     // assert(tx >= 0 && ty >= 0);
     // assert(tx < width && ty < height);
@@ -39,6 +65,8 @@ void UIContext::setRotation(uint8_t r) {
 
 void UIContext::setTextColor(uint16_t c, uint16_t bg) {
     display.setTextColor(c, bg);
+    text_fg = c;
+    text_bg = bg;
 }
 
 void UIContext::setTextColor(uint32_t c, uint32_t bg) {
@@ -57,116 +85,73 @@ void UIContext::resetColors() {
     setTextColor(theme.foreground, theme.background);
 }
 
-void UIContext::print(const String& text, const bool colorized) {
-    display.setCursor(x, y);
-
-    if (!colorized) {
-        display.print(text);
-        sync();
+void UIContext::print(const char* text, const bool colorized) {
+    if (colorized) {
+        printMarkup(text);
         return;
     }
 
+    display.setCursor(x, y);
+    write(text);
+    sync();
+}
+
+void UIContext::print(char c) {
+    display.setCursor(x, y);
+    write(c);
+    sync();
+}
+
+void UIContext::printn(const char* text, size_t length) {
+    display.setCursor(x, y);
+    for (size_t i = 0; i < length && text[i]; i++) write(text[i]);
+    sync();
+}
+
+void UIContext::println(const char* text, const bool colorized) {
+    print(text, colorized);
+    print('\n');
+}
+
+void UIContext::println(char c) {
+    print(c);
+    print('\n');
+}
+
+void UIContext::printMarkup(const char* text) {
+    display.setCursor(x, y);
 #ifdef HAS_COLOR
-    std::vector<uint16_t> color_stack{};
-    int32_t bracket_pos = -1;
-    String color_buf = "";
     resetColors();
-    for (uint16_t i = 0; i < text.length(); i++) {
-        char c = text.charAt(i);
-        if (c == '[') {
-            if (bracket_pos == -1) {
-                bracket_pos = i;
-                color_buf = "";
-            } else if (bracket_pos == i - 1) {
-                display.print('['); // [[ -> [
-                bracket_pos = -1;
-            }
-            continue;
-        }
-
-        if (bracket_pos >= 0) {
-            uint16_t innerPos = i - bracket_pos;
-
-            if (innerPos == 1 && c != ']') {
-                if (c == '#') {
-                    color_buf = "#";
-                } else {
-                    display.print("[#");
-                    bracket_pos = -1;
-                    color_buf = "";
-                }
-                continue;
-            }
-
-            if (isxdigit(c)) {
-                if (color_buf.length() < 7)
-                    color_buf += c;
-                else {
-                    display.print("[");
-                    display.print(color_buf);
-                    bracket_pos = -1;
-                    color_buf = "";
-                }
-                continue;
-            }
-
-            if (c == ']') {
-                if (innerPos == 1) {  // []
-                    if (!color_stack.empty()) color_stack.pop_back();
-                    setTextColor(!color_stack.empty() ? color_stack.back() : theme.foreground);
-                } else if (innerPos == 2) {  // [#]
-                    color_stack.clear();
-                    setTextColor(theme.foreground);
-                } else {
-                    uint16_t color = rgb565(strtoul(color_buf.c_str() + 1, nullptr, 16));
-                    setTextColor(color);
-                    color_stack.push_back(color);
-                }
-                bracket_pos = -1;
-                color_buf = "";
-                continue;
-            }
-
-            display.print("[");
-            display.print(color_buf);
-            bracket_pos = -1;
-            color_buf = "";
-        }
+#endif
+    Markup::parse(text, [this](char c) { write(c); }, [this](uint16_t color, bool themed) {
+#ifdef HAS_COLOR
+        setTextColor(themed ? theme.foreground : color);
+#endif
+    });
+    sync();
+}
 
-        display.print(c);
-    }
-    // resetColors();
-#else
-    for (uint16_t i = 0; i < text.length(); i++) {
-        char c = text.charAt(i);
-        if (c == '[') {
-            int j = i + 1;
-            if (j < text.length() && text.charAt(j) == '[') {
-                display.print('[');
-                i = j;
-            } else {
-                bool is_tag = false;
-                int end = j;
-                while (end < text.length() && text.charAt(end) != ']') {
-                    end++;
-                }
-                if (end < text.length() && text.charAt(end) == ']') {
-                    is_tag = true;
-                    i = end;
-                }
-
-                if (!is_tag) {
-                    display.print('[');
-                }
-            }
-        } else {
-            display.print(c);
-        }
-    }
+void UIContext::print(const Markup& markup) {
+    display.setCursor(x, y);
+#ifdef HAS_COLOR
+    resetColors();
+#endif
+    const char* text = markup.plain();
+    for (uint16_t i = 0; i < markup.spanCount(); i++) {
+        const MarkupSpan& span = markup.span(i);
+#ifdef HAS_COLOR
+        setTextColor(span.themed ? theme.foreground : span.color);
 #endif
+        for (uint16_t j = 0; j < span.length; j++) write(text[span.offset + j]);
+    }
     sync();
 }
 
+void UIContext::println(const Markup& markup) {
+    print(markup);
+    print('\n');
+}
+
 void UIContext::printf(const char* format, ...) {
     char buffer[128];
 
@@ -175,7 +160,7 @@ void UIContext::printf(const char* format, ...) {
     vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
 
-    print(String(buffer));
+    print(buffer);
 }
 
 void UIContext::printfColor(const char* format, ...) {
@@ -186,7 +171,7 @@ void UIContext::printfColor(const char* format, ...) {
     vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
 
-    print(String(buffer), true);
+    printMarkup(buffer);
 }
 
 uint8_t UIContext::availableSpaces(uint8_t chars) const {
@@ -200,31 +185,212 @@ void UIContext::sync() {
     height = display.height();
 }
 
-void UIContext::reset() {
+void UIContext::clearScreen() {
+#ifdef DISPLAY_ASYNC_FLUSH
+    display.fence();
+#endif
     display.fillScreen(theme.background);
     setCursor(0, 0);
     resetColors();
     sync();
 }
 
-void UIContext::render(UIApp& app) {
-    reset();
-#if   DISPLAY_MODE == DISPLAY_MODE_BUFFERED
-    app.render(*this);
-    display.display();
+void UIContext::reset() {
+    clearScreen();
+    invalidate();
+}
 
-#elif DISPLAY_MODE == DISPLAY_MODE_EINK
-    if (refresh_full || ++partial_updates >= partial_cap) {
-        display.setFullWindow();
-        partial_updates = 0;
+void UIContext::invalidate() {
+    invalidated = true;
+}
+
+void UIContext::scrolled(int16_t rows) {
+#ifdef HAS_HW_SCROLL
+    display.scrolled(rows * charHeight());
+#endif
+}
+
+void UIContext::shade(uint16_t color) {
+    invalidate();
+#ifdef HAS_PATTERN_FILL
+    display.fillChecker(color);
+#else
+    for (int16_t ty = 0; ty < height; ty++) {
+        for (int16_t tx = (ty + 1) % 2; tx < width; tx += 2) display.writePixel(tx, ty, color);
+    }
+#endif
+}
+
+#ifdef HAS_COLOR
+bool UIContext::sameCell(const TextCell& cell, char c, uint16_t fg, uint16_t bg) {
+    return cell.ch == c && cell.bg == bg && (c == ' ' || cell.fg == fg);
+}
+
+void UIContext::storeCell(TextCell& cell, char c, uint16_t fg, uint16_t bg) {
+    cell.ch = c;
+    cell.fg = fg;
+    cell.bg = bg;
+}
+#else
+bool UIContext::sameCell(const TextCell& cell, char c, uint16_t fg, uint16_t bg) {
+    uint8_t ink = (fg != 0) | (bg != 0) << 1;
+    return cell.ch == c && (cell.ink & 2) == (ink & 2) && (c == ' ' || cell.ink == ink);
+}
+
+void UIContext::storeCell(TextCell& cell, char c, uint16_t fg, uint16_t bg) {
+    cell.ch = c;
+    cell.ink = (fg != 0) | (bg != 0) << 1;
+}
+#endif
+
+void UIContext::drawGlyph(int16_t gx, int16_t gy, char c) {
+#ifdef HAS_GLYPH_BLIT
+    display.drawGlyph(gx, gy, c, text_fg, text_bg);
+#else
+    display.drawChar(gx, gy, c, text_fg, text_bg, 1);
+#endif
+}
+
+void UIContext::writeScaled(char c, int16_t cx, int16_t cy) {
+    const int16_t w = charWidth(), h = charHeight();
+    if (c == '\n') {
+        display.setCursor(0, cy + h);
+        return;
+    }
+    if (c == '\r') return;
+
+    if (cx + w > width) {
+        cx = 0;
+        cy += h;
+    }
+
+    uint8_t* bits = scaled_glyphs.get(c, w, h); // cp437 layout, which main() selects
+    if (bits == nullptr) {
+        display.setCursor(cx, cy);
+        display.write(c);
+        return;
+    }
+    if (text_fg == text_bg) display.drawBitmap(cx, cy, bits, w, h, text_fg);
+    else display.drawBitmap(cx, cy, bits, w, h, text_fg, text_bg);
+    display.setCursor(cx + w, cy);
+}
+
+void UIContext::write(char c) {
+    int16_t cx = display.getCursorX();
+    int16_t cy = display.getCursorY();
+
+    // anything off the character grid bypasses the cells
+    if (text_size != 1) {
+        invalidate();
+        writeScaled(c, cx, cy);
+        return;
+    }
+    if (cx % glyph_width || cy % glyph_height) {
+        invalidate();
+        display.write(c);
+        return;
+    }
+
+    if (c == '\n') {
+        display.setCursor(0, cy + glyph_height);
+        return;
+    }
+    if (c == '\r') return;
+
+    if (cx + glyph_width > width) { // wrap like Adafruit_GFX does
+        cx = 0;
+        cy += glyph_height;
+    }
+
+    int16_t col = cx / glyph_width;
+    int16_t row = cy / glyph_height;
+    if (cy >= 0 && row < rows && col < cols) {
+        TextCell& cell = cells[row * cols + col];
+        cell.drawn = true;
+        if (!sameCell(cell, c, text_fg, text_bg)) {
+            storeCell(cell, c, text_fg, text_bg);
+            damaged.add(cx, cy, glyph_width, glyph_height);
+            drawGlyph(cx, cy, c);
+        } else if (full_draw) {
+            drawGlyph(cx, cy, c);
+        }
+    } else {
+        drawGlyph(cx, cy, c);
+    }
+    display.setCursor(cx + glyph_width, cy);
+}
+
+void UIContext::beginFrame() {
+#ifdef DISPLAY_ASYNC_FLUSH
+    display.fence(); // the last frame may still be going out of this buffer
+#endif
+    invalidated = false;
+    damaged = {};
+
+    uint8_t c = width / glyph_width;
+    uint8_t r = height / glyph_height;
+    if (c != cols || r != rows || cached_bg != theme.background) {
+        cols = c;
+        rows = r;
+        cached_bg = theme.background;
+        cached = false;
+    }
+
+    for (uint16_t i = 0; i < cols * rows; i++) {
+        if (!cached) storeCell(cells[i], ' ', theme.foreground, theme.background);
+        cells[i].drawn = false;
+    }
+    if (!cached) damaged = {0, 0, width, height};
+
+    full_draw = !cached;
+    if (full_draw) {
+        clearScreen();
     } else {
-        display.setPartialWindow(0, 0, width, height);
+        setCursor(0, 0);
+        resetColors();
     }
+}
 
-    display.firstPage();
-    do {
+void UIContext::endFrame() {
+    if (invalidated) { // graphics the cells know nothing about, start the next frame from scratch
+        cached = false;
+        damaged = {0, 0, width, height};
+        return;
+    }
+
+    for (uint8_t r = 0; r < rows; r++) {
+        for (uint8_t c = 0; c < cols; c++) {
+            TextCell& cell = cells[r * cols + c];
+            if (cell.drawn || sameCell(cell, ' ', theme.foreground, theme.background)) continue;
+
+            if (!full_draw) display.fillRect(c * glyph_width, r * glyph_height, glyph_width, glyph_height, theme.background);
+            storeCell(cell, ' ', theme.foreground, theme.background);
+            damaged.add(c * glyph_width, r * glyph_height, glyph_width, glyph_height);
+        }
+    }
+    cached = true;
+}
+
+void UIContext::render(UIApp& app) {
+    PROBE("render");
+    animation_requested = false;
+    beginFrame();
+#if DISPLAY_MODE == DISPLAY_MODE_BUFFERED || DISPLAY_MODE == DISPLAY_MODE_EINK
+    app.render(*this);
+    if (invalidated && !full_draw) { // found out too late, redo it as a full frame
+        cached = false;
+        beginFrame();
         app.render(*this);
-    } while (display.nextPage());
+    }
+    endFrame();
+    {
+        PROBE("flush");
+#if DISPLAY_MODE == DISPLAY_MODE_EINK
+        if (refresh_full || !damaged.empty()) display.refreshWindow(damaged.x, damaged.y, damaged.w, damaged.h, refresh_full);
+#else
+        display.display();
+#endif
+    }
 
 #else
 #error "Invalid display mode specified. Check implementation"
@@ -240,7 +406,7 @@ void UIContext::flush() {
 #elif DISPLAY_MODE == DISPLAY_MODE_BUFFERLESS
     // indeed bufferless
 #elif DISPLAY_MODE == DISPLAY_MODE_EINK
-    display.nextPage(); // may not always work
+    display.refreshWindow(0, 0, width, height);
 #else
 #error "Invalid display mode specified. Check implementation"
 #endif
@@ -250,3 +416,8 @@ void UIContext::refresh(bool full) {
     refresh_requested = true;
     refresh_full = full || refresh_full;
 }
+
+void UIContext::animate(uint32_t in_ms) {
+    if (!animation_requested || in_ms < animation_delay) animation_delay = in_ms;
+    animation_requested = true;
+}
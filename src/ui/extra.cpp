@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "ui/extra.h"
 #include "keycodes.h"
 #include "utils.h"
@@ -15,15 +17,15 @@ void CharTable::render(UIContext& ctx, bool minimalized) {
             if (y == 0x10) {
                 ctx.println(" -+----------------+-");
             } else {
-                ctx.print(String(' '));
+                ctx.print(' ');
                 ctx.printf("%x", y);
-                ctx.print("|");
+                ctx.print('|');
                 for (uint8_t x = 0; x < 16; x++) {
                     char c = static_cast<char>(x + y * 16);
                     if (c == 0x0A || c == 0x0D || c == '\n' || c == '\t') c = ' ';
-                    ctx.print(String(c));
+                    ctx.print(c);
                 }
-                ctx.print("|");
+                ctx.print('|');
                 ctx.printf("%x\n", y);
             }
         }
@@ -31,6 +33,7 @@ void CharTable::render(UIContext& ctx, bool minimalized) {
 }
 
 bool CharTable::update(UIContext& ctx, char key) {
+    const int16_t from = start;
     if (key == KEY_UP) {
         start--;
         if (start < 0) start++;
@@ -41,6 +44,7 @@ bool CharTable::update(UIContext& ctx, char key) {
         return false;
     }
 
+    ctx.scrolled(start - from);
     return true;
 }
 
@@ -48,9 +52,38 @@ bool CharTable::update(UIContext& ctx, char key) {
 /*********************/
 /**** BandScanner ****/
 /*********************/
+void BandScanner::sweep() {
+    const Scan& last = scans[shown];
+    Scan& next = scans[shown ^ 1];
+    next.lo = 999;
+    next.hi = -999;
+    for (uint16_t idx = 0; idx < SCAN_POINTS; idx++) {
+        radioPtr->setFrequency(start + idx * step);
+        float rssi = radioPtr->getRSSI(false);
+
+        float alpha = 0.35;
+        if (last.rssi[idx] <= -145) {
+            next.rssi[idx] = rssi;
+        } else {
+            next.rssi[idx] = alpha * rssi + (1 - alpha) * last.rssi[idx];
+        }
+        next.hi = std::max(next.hi, next.rssi[idx]);
+        next.lo = std::min(next.lo, next.rssi[idx]);
+    }
+
+    if (retune) retune();
+    else        radioPtr->setFrequency(settings.data.radio_frequency);
+}
+
+void BandScanner::finish() {
+    shown ^= 1;
+    sweeping.store(false, std::memory_order_release);
+}
+
 void BandScanner::render(UIContext& ctx, bool minimalized) {
     if (minimalized) {
-        ctx.println(getLabel());
+        printLabel(ctx);
+        ctx.println();
         return;
     }
 
@@ -59,39 +92,31 @@ void BandScanner::render(UIContext& ctx, bool minimalized) {
         return;
     };
 
-    min_rssi = 999;
-    max_rssi = -999;
-    for (float freq = start; freq <= end; freq += step) {
-        uint16_t idx = round((freq - start) / step);
-        radioPtr->setFrequency(freq);
-        float rssi = radioPtr->getRSSI(false);
-
-        float alpha = 0.35;
-        if (last_scan[idx] <= -145) {
-            last_scan[idx] = rssi;
-        } else {
-            last_scan[idx] = alpha * rssi + (1 - alpha) * last_scan[idx];
-        }
-        if (max_rssi == -999 || last_scan[idx] > max_rssi) {
-            max_rssi = last_scan[idx];
-        }
-        if (min_rssi == 999 || last_scan[idx] < min_rssi) {
-            min_rssi = last_scan[idx];
+    if (!sweeping.exchange(true, std::memory_order_acquire)) {
+        if (!sweeper) {
+            sweep();
+            finish();
+        } else if (!sweeper(this)) {
+            sweeping.store(false, std::memory_order_relaxed); // queue full, try again next frame
         }
     }
-    radioPtr->setFrequency(settings.data.radio_frequency);
+    ctx.animate();
+
+    const Scan& scan = scans[shown];
+    if (scan.hi <= scan.lo) return;
 
-    for (uint8_t i = 0; i < 127; i++) {
-        float v1 = last_scan[i];
-        float v2 = last_scan[i + 1];
+    ctx.invalidate();
+    for (uint8_t i = 0; i < SCAN_POINTS - 1; i++) {
+        float v1 = scan.rssi[i];
+        float v2 = scan.rssi[i + 1];
 
-        uint8_t l1 = ((v1 - min_rssi) * 48) / (max_rssi - min_rssi);
-        uint8_t l2 = ((v2 - min_rssi) * 48) / (max_rssi - min_rssi);
+        uint8_t l1 = ((v1 - scan.lo) * 48) / (scan.hi - scan.lo);
+        uint8_t l2 = ((v2 - scan.lo) * 48) / (scan.hi - scan.lo);
 
         ctx.display.drawLine(i, 64-l1-8-1, i+1, 64-l2-8-1, ctx.theme.fg);
     }
     ctx.setCharCursor(0, 7);
-    ctx.printf("%.0f <-> %.0f", min_rssi, max_rssi);
+    ctx.printf("%.0f <-> %.0f", scan.lo, scan.hi);
 }
 
 bool BandScanner::update(UIContext& ctx, char key) {
@@ -99,12 +124,151 @@ bool BandScanner::update(UIContext& ctx, char key) {
 }
 
 
+/*******************/
+/**** ProbeView ****/
+/*******************/
+void ProbeView::render(UIContext& ctx, bool minimalized) {
+    if (minimalized) {
+        printLabel(ctx);
+        ctx.println();
+        return;
+    }
+
+    if (!ProbeSite::first()) ctx.println("No samples");
+
+    int8_t row = 0;
+    int8_t rows = (ctx.maxCharsY() - 1) / 2; // two lines per site
+    for (ProbeSite* s = ProbeSite::first(); s && row < start + rows; s = s->next(), row++) {
+        if (row < start) continue;
+        ctx.println(s->name());
+        ctx.printf(" %lu/%lu/%luus x%lu\n", (unsigned long)s->avgUs(), (unsigned long)s->minUs(),
+                   (unsigned long)s->maxUs(), (unsigned long)s->count());
+    }
+    ctx.animate(1000);
+}
+
+bool ProbeView::update(UIContext& ctx, char key) {
+    if (key == KEY_UP) {
+        if (start > 0) start--;
+    } else if (key == KEY_DOWN) {
+        int8_t sites = 0;
+        for (ProbeSite* s = ProbeSite::first(); s; s = s->next()) sites++;
+        if (start < sites - 1) start++;
+    } else if (key == KEY_ENTER) {
+        ProbeSite::resetAll();
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+
+/*******************/
+/**** AllocView ****/
+/*******************/
+void AllocView::render(UIContext& ctx, bool minimalized) {
+    if (minimalized) {
+        printLabel(ctx);
+        ctx.println();
+        return;
+    }
+
+    ctx.printf("Live %lu pk %lu\n", (unsigned long)AllocTracker::liveBytes(), (unsigned long)AllocTracker::peakBytes());
+
+    // tags then call sites, two lines each
+    AllocSite top[ALLOC_SITES];
+    int8_t tags = static_cast<int8_t>(AllocTag::COUNT);
+    int8_t entries = tags + AllocTracker::topSites(top, ALLOC_SITES);
+    int8_t rows = (ctx.maxCharsY() - 2) / 2;
+    for (int8_t i = start; i < entries && i < start + rows; i++) {
+        if (i < tags) {
+            const AllocStats& s = AllocTracker::stats(static_cast<AllocTag>(i));
+            ctx.printf("%s x%lu ov%lu\n", AllocTracker::tagName(static_cast<AllocTag>(i)),
+                       (unsigned long)s.scopes, (unsigned long)s.overruns);
+            ctx.printf(" %lu/%lu pk%luB\n", (unsigned long)(s.scopes ? s.allocs / s.scopes : s.allocs),
+                       (unsigned long)s.worst, (unsigned long)s.peak);
+        } else {
+            const AllocSite& s = top[i - tags];
+            ctx.printf("0x%08lX\n", (unsigned long)s.addr);
+            ctx.printf(" x%lu %luB\n", (unsigned long)s.count, (unsigned long)s.bytes);
+        }
+    }
+    ctx.animate(1000);
+}
+
+bool AllocView::update(UIContext& ctx, char key) {
+    if (key == KEY_UP) {
+        if (start > 0) start--;
+    } else if (key == KEY_DOWN) {
+        AllocSite top[ALLOC_SITES];
+        int8_t entries = static_cast<int8_t>(AllocTag::COUNT) + AllocTracker::topSites(top, ALLOC_SITES);
+        if (start < entries - 1) start++;
+    } else if (key == KEY_ENTER) {
+        AllocTracker::reset();
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+
+/********************/
+/**** MemoryView ****/
+/********************/
+void MemoryView::render(UIContext& ctx, bool minimalized) {
+    if (minimalized) {
+        printLabel(ctx);
+        ctx.println();
+        return;
+    }
+
+    char used[12], total[12];
+    prettyValue(used, sizeof(used), driver->currentRam(), "B", 1, 1024);
+    prettyValue(total, sizeof(total), driver->maxRam(), "B", 0, 1024);
+    ctx.printf("RAM   %s/%s\n", used, total);
+    prettyValue(used, sizeof(used), driver->freeHeap(), "B", 1, 1024);
+    ctx.printf("Free  %s\n", used);
+    prettyValue(used, sizeof(used), driver->largestFreeBlock(), "B", 1, 1024);
+    ctx.printf("Block %s\n", used);
+    prettyValue(used, sizeof(used), driver->heapHighWater(), "B", 1, 1024);
+    ctx.printf("Peak  %s\n", used);
+    for (uint8_t core = 0; core < driver->cores(); core++) {
+        prettyValue(used, sizeof(used), driver->stackHighWater(core), "B", 1, 1024);
+        prettyValue(total, sizeof(total), driver->stackSize(core), "B", 0, 1024);
+        ctx.printf("Stk%u  %s/%s\n", core, used, total);
+    }
+    ctx.animate(1000);
+}
+
+
+/******************/
+/**** BootView ****/
+/******************/
+void BootView::render(UIContext& ctx, bool minimalized) {
+    if (minimalized) {
+        printLabel(ctx);
+        ctx.println();
+        return;
+    }
+
+    char line[24];
+    for (uint8_t i = 0; log && i < log->stages(); i++) {
+        snprintf(line, sizeof(line), "%-8s%5lu%6lu", log->name(i),
+                 (unsigned long)(log->took(i) / 1000), (unsigned long)(log->at(i) / 1000));
+        ctx.println(line);
+    }
+}
+
+
 /********************/
 /**** ColorWheel ****/
 /********************/
 void ColorWheel::render(UIContext& ctx, bool minimalized) {
     if (minimalized) {
-        ctx.println(getLabel());
+        printLabel(ctx);
+        ctx.println();
         return;
     }
 
@@ -146,7 +310,8 @@ SizeDemo::SizeDemo(const Config& cfg) {
 
 void SizeDemo::render(UIContext& ctx, bool minimalized) {
     if (minimalized) {
-        ctx.println(getLabel());
+        printLabel(ctx);
+        ctx.println();
         return;
     }
 
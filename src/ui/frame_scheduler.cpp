@@ -0,0 +1,62 @@
+#include "ui/frame_scheduler.h"
+
+#include <algorithm>
+
+/************************/
+/**** FrameScheduler ****/
+/************************/
+void FrameScheduler::input(uint32_t key_time) {
+    if (!has_input || static_cast<int32_t>(key_time - input_time) < 0) input_time = key_time;
+    has_input = true;
+    pending = true;
+}
+
+void FrameScheduler::animate(uint32_t at) {
+    if (!animating || static_cast<int32_t>(at - animate_at) < 0) animate_at = at;
+    animating = true;
+}
+
+uint32_t FrameScheduler::animationInterval() const {
+    return std::max(min_interval, frame_cost * FRAME_DUTY);
+}
+
+uint32_t FrameScheduler::untilFrame(uint32_t now) const {
+    if (pending) return 0;
+    if (!animating) return FRAME_NONE;
+
+    uint32_t at = animate_at;
+    uint32_t paced = last_frame + animationInterval();
+    if (static_cast<int32_t>(paced - at) > 0) at = paced;
+
+    int32_t left = static_cast<int32_t>(at - now);
+    return left > 0 ? left : 0;
+}
+
+void FrameScheduler::begin(uint32_t now) {
+    frame_start = now;
+    frame_has_input = has_input;
+    frame_input = input_time;
+    has_input = false;
+    pending = false;
+    animating = false; // elements ask again while rendering
+}
+
+void FrameScheduler::end(uint32_t now) {
+    uint32_t cost = now - frame_start;
+    frame_cost = frame_cost ? (3 * frame_cost + cost) / 4 : cost;
+    last_frame = frame_start;
+
+    if (!frame_has_input) return;
+    latency[latency_pos] = std::min<uint32_t>(now - frame_input, UINT16_MAX);
+    latency_pos = (latency_pos + 1) % FRAME_LATENCY_SAMPLES;
+    if (latency_count < FRAME_LATENCY_SAMPLES) latency_count++;
+}
+
+uint16_t FrameScheduler::latencyPercentile(uint8_t p) const {
+    if (!latency_count) return 0;
+
+    uint16_t sorted[FRAME_LATENCY_SAMPLES];
+    std::copy(latency, latency + latency_count, sorted);
+    std::sort(sorted, sorted + latency_count);
+    return sorted[std::min<uint32_t>(latency_count - 1, latency_count * p / 100)];
+}
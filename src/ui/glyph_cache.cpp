@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cstring>
+
+#include "ui/glyph_cache.h"
+#include "displays/glyph_blitter.h"
+
+#define FONT_W 6
+#define FONT_H 8
+
+/********************/
+/**** GlyphCache ****/
+/********************/
+void GlyphCache::rasterize(uint8_t c, uint8_t w, uint8_t h, uint8_t* out) {
+    const uint8_t stride = (w + 7) / 8;
+    memset(out, 0, bytes(w, h));
+
+    uint8_t columns[FONT_W];
+    for (uint8_t i = 0; i < FONT_W; i++) columns[i] = GlyphBlitter::column(c, i);
+
+    if (w % FONT_W == 0 && h % FONT_H == 0) { // whole scale: plain pixel repetition
+        for (uint8_t y = 0; y < h; y++) {
+            for (uint8_t x = 0; x < w; x++) {
+                if (columns[x * FONT_W / w] >> (y * FONT_H / h) & 1) out[y * stride + x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        return;
+    }
+
+    // in units where a font pixel is w (h) wide and an output pixel FONT_W (FONT_H),
+    // so both grids are whole numbers and overlaps are products of plain integers
+    for (uint8_t y = 0; y < h; y++) {
+        const uint16_t y0 = y * FONT_H, y1 = y0 + FONT_H;
+        for (uint8_t x = 0; x < w; x++) {
+            const uint16_t x0 = x * FONT_W, x1 = x0 + FONT_W;
+            uint16_t covered = 0;
+
+            for (uint8_t i = x0 / w; i < FONT_W && i * w < x1; i++) {
+                uint16_t ox = std::min<uint16_t>(x1, (i + 1) * w) - std::max<uint16_t>(x0, i * w);
+                for (uint8_t j = y0 / h; j < FONT_H && j * h < y1; j++) {
+                    if (!(columns[i] >> j & 1)) continue;
+                    covered += ox * (std::min<uint16_t>(y1, (j + 1) * h) - std::max<uint16_t>(y0, j * h));
+                }
+            }
+            if (2 * covered >= FONT_W * FONT_H) out[y * stride + x / 8] |= 0x80 >> (x % 8);
+        }
+    }
+}
+
+void GlyphCache::evict(uint8_t i) {
+    const uint16_t size = bytes(slots[i].w, slots[i].h);
+    const uint16_t from = slots[i].offset + size;
+
+    memmove(pool + slots[i].offset, pool + from, end - from);
+    end -= size;
+    for (uint8_t k = i + 1; k < count; k++) {
+        slots[k - 1] = slots[k];
+        slots[k - 1].offset -= size;
+    }
+    count--;
+}
+
+uint8_t* GlyphCache::get(uint8_t c, uint8_t w, uint8_t h) {
+    clock++;
+    for (uint8_t i = 0; i < count; i++) {
+        Slot& s = slots[i];
+        if (s.c == c && s.w == w && s.h == h) {
+            s.used_at = clock;
+            return pool + s.offset;
+        }
+    }
+
+    const uint16_t size = bytes(w, h);
+    if (size > GLYPH_CACHE_BYTES) return nullptr;
+    if (pool == nullptr) {
+        pool = new uint8_t[GLYPH_CACHE_BYTES];
+        slots = new Slot[GLYPH_CACHE_SLOTS];
+    }
+
+    while (count == GLYPH_CACHE_SLOTS || end + size > GLYPH_CACHE_BYTES) {
+        uint8_t oldest = 0;
+        for (uint8_t i = 1; i < count; i++) {
+            if (slots[i].used_at < slots[oldest].used_at) oldest = i;
+        }
+        evict(oldest);
+    }
+
+    slots[count] = {clock, end, c, w, h};
+    count++;
+    rasterize(c, w, h, pool + end);
+    end += size;
+    return pool + end - size;
+}
@@ -39,20 +39,17 @@ void NumberPicker<T>::render(UIContext& ctx, bool /*minimalized*/) {
     T v = getValue();
     uint8_t total = getDigits();
     uint8_t num_len = total + (precision > 0) + suffix.length() + (v < 0); // digits + dec. point + suffix + neg. sign
-    String prefix = getLabel(ctx.availableCharsX() - num_len);
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + num_len);
     int64_t scale = pow10i(precision);
     int64_t scaled = std::llround(static_cast<double>(getAbsoluteValue()) * scale);
 
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; ++i) ctx.print(' ');
-    if (v < 0) ctx.print("-");
+    printPrefix(ctx, num_len);
+    if (v < 0) ctx.print('-');
 
     for (int i = total; i >= 1; --i) {
         int64_t div = pow10i(i - 1);
         int digit = static_cast<int>((scaled / div) % 10);
-        if (i == precision) ctx.print(".");
-        ctx.printf("%d", digit);
+        if (i == precision) ctx.print('.');
+        ctx.print(static_cast<char>('0' + digit));
     }
 
     ctx.println(suffix);
@@ -63,25 +60,22 @@ void NumberPicker<T>::renderInline(UIContext& ctx) {
     T v = getValue();
     uint8_t total = getDigits();
     uint8_t num_len = total + (precision > 0) + suffix.length() + (v < 0); // digits + dec. point + suffix + neg. sign
-    String prefix = getLabel(ctx.availableCharsX() - num_len);
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + num_len);
     int64_t scale = pow10i(precision);
     int64_t scaled = std::llround(static_cast<double>(getAbsoluteValue()) * scale);
 
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; ++i) ctx.print(' ');
-    if (v < 0) ctx.print("-");
+    printPrefix(ctx, num_len);
+    if (v < 0) ctx.print('-');
 
     for (int i = total; i >= 1; --i) {
         int64_t div = pow10i(i - 1);
         int digit = static_cast<int>((scaled / div) % 10);
 
-        if (i == precision) ctx.print(".");
+        if (i == precision) ctx.print('.');
 
         if (i == cursor + 1)    ctx.invertColors();
         else                    ctx.resetColors();
 
-        ctx.printf("%d", digit);
+        ctx.print(static_cast<char>('0' + digit));
         ctx.resetColors();
     }
 
@@ -170,23 +164,19 @@ bool NumberPicker<T>::update(UIContext& ctx, char key) {
 /******************/
 void Selector::render(UIContext& ctx, bool /* minimalized */) {
     if (cursor == -1) cursor = selection != nullptr ? *selection : 0;
-    String current = items.at(cursor) + suffix;
-    String prefix = getLabel(ctx.availableCharsX() - current.length());
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + current.length());
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
-    ctx.println(current);
+    const String& current = items.at(cursor);
+    printPrefix(ctx, current.length() + suffix.length());
+    ctx.print(current);
+    ctx.println(suffix);
 }
 
 void Selector::renderInline(UIContext& ctx) {
-    String current = items.at(cursor) + suffix;
-    String prefix = getLabel(ctx.availableCharsX() - current.length());
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + current.length());
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
+    const String& current = items.at(cursor);
+    printPrefix(ctx, current.length() + suffix.length());
 
     ctx.invertColors();
     ctx.print(current);
+    ctx.print(suffix);
     ctx.resetColors();
 }
 
@@ -213,10 +203,7 @@ bool Selector::update(UIContext& ctx, char key) {
 /**** Toggle ****/
 /****************/
 void Toggle::render(UIContext& ctx, bool minimalized) {
-    String prefix = getLabel(ctx.availableCharsX() - 3);
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + 3);
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
+    printPrefix(ctx, 3);
     ctx.print('[');
     ctx.print(*ptr ? 'x' : ' ');
     ctx.println(']');
@@ -231,7 +218,10 @@ void Toggle::activate(UIContext& /* ctx */) {
 /**** Button ****/
 /****************/
 void Button::render(UIContext& ctx, bool minimalized) {
-    ctx.println("[" + getLabel(ctx.availableCharsX() - 2) + "]");
+    int16_t available = ctx.availableCharsX() - 2;
+    ctx.print('[');
+    printLabel(ctx, available);
+    ctx.println(']');
 }
 
 void Button::activate(UIContext& ctx) {
@@ -247,20 +237,14 @@ void TextField::render(UIContext& ctx, bool minimalized) { // TODO: implement dy
     if (ptr == nullptr) return;
     if (cursor == -1) cursor = strlen(ptr);
 
-    String prefix = getLabel();
-    String data = ptr;
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + data.length());
-
-    if (prefix.length() == 0 || !spacer) spaces = 0;
-
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < (spacer ? spaces : 0); i++) ctx.print(' ');
+    uint8_t length = strlen(ptr);
+    uint8_t spaces = printLabel(ctx) && spacer ? ctx.availableSpaces(length) : 0;
+    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
 
-    if (data.length() <= window_size) {
-        ctx.println(data);
+    if (length <= window_size) {
+        ctx.println(ptr);
     } else {
-        data = data.substring(window_size-1);
-        ctx.println(data);
+        ctx.println(ptr + window_size - 1);
         ctx.print('\x96');
     }
 }
@@ -269,59 +253,60 @@ void TextField::renderInline(UIContext& ctx) {
     if (ptr == nullptr) return;
     if (cursor == -1) cursor = strlen(ptr);
 
-    String prefix = getLabel();
-    if (window_size < 0) window_size = ctx.maxCharsX()-prefix.length();
-    String data = ptr;
-    uint8_t size = data.length();
-    bool has_cursor = data.length() < max_length && cursor == data.length();
-    if (has_cursor && data.length() > window_size-1) {
-        data = data.substring(slice_at+1, std::min<uint8_t>(slice_at+window_size, data.length()));
-    } else {
-        data = data.substring(slice_at, std::min<uint8_t>(slice_at+window_size, data.length()));
-    }
+    int16_t label_length = labelLength(icon, title.c_str());
+    if (window_size < 0) window_size = ctx.maxCharsX()-label_length;
+    uint8_t size = strlen(ptr);
+    bool has_cursor = size < max_length && cursor == size;
 
-    if (slice_at || (has_cursor && size > window_size-1)) data.setCharAt(0, '\x96'); // left trim
-    if (slice_at+window_size < size) data.setCharAt(data.length()-1, '\x96'); // right trim
+    // visible slice of the text, the same bounds String::substring() would clamp to
+    uint8_t from = has_cursor && size > window_size-1 ? slice_at+1 : slice_at;
+    uint8_t to = std::min<uint8_t>(slice_at+window_size, size);
+    if (from > to) std::swap(from, to);
+    uint8_t length = to - from;
 
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + data.length());
+    bool trim_left = slice_at || (has_cursor && size > window_size-1);
+    bool trim_right = slice_at+window_size < size;
 
-    if (prefix.length() == 0 || !spacer) spaces = 0;
+    uint8_t spaces = ctx.availableSpaces(label_length + length);
+    if (label_length == 0 || !spacer) spaces = 0;
 
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < (spacer ? spaces : 0); i++) ctx.print(' ');
+    printLabel(ctx);
+    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
 
-    for (uint8_t i = 0; i < data.length(); i++) {
+    for (uint8_t i = 0; i < length; i++) {
+        char c = (i == 0 && trim_left) || (i == length-1 && trim_right) ? '\x96' : ptr[from + i];
         if (i == cursor-slice_at) {
             if (millis() / 500 % 2 || DISPLAY_MODE == DISPLAY_MODE_EINK) ctx.invertColors();
-            ctx.print(data.charAt(i));
+            ctx.print(c);
             ctx.resetColors();
             has_cursor = false;
         } else {
-            ctx.print(data.charAt(i));
+            ctx.print(c);
         }
     };
 
     if (has_cursor) ctx.print((millis() / 500 % 2 || DISPLAY_MODE == DISPLAY_MODE_EINK) ? '_' : ' ');
     ctx.println();
+#if DISPLAY_MODE != DISPLAY_MODE_EINK
+    ctx.animate(500 - millis() % 500); // next blink phase
+#endif
 }
 
 bool TextField::update(UIContext& ctx, char key) {
     if (ptr == nullptr) return false;
 
-    String buf = ptr; // I know using Strings may be inefficient, but it is much more convenient
+    uint8_t length = strlen(ptr);
     if (key >= ' ' && key <= '~') {
-        if (buf.length() < max_length) {
-            String start = buf.substring(0, cursor);
-            String end = cursor < buf.length() ? buf.substring(cursor) : "";
-            buf = start + key + end;
+        if (length < max_length) {
+            memmove(ptr + cursor + 1, ptr + cursor, length - cursor + 1);
+            ptr[cursor] = key;
+            length++;
             cursor++;
-            if (buf.length() > window_size) slice_at++;
+            if (length > window_size) slice_at++;
         }
     } else if (key == KEY_BACK) {
         if (cursor > 0) {
-            String start = cursor > 0 ? buf.substring(0, cursor-1) : "";
-            String end = cursor < buf.length() ? buf.substring(cursor) : "";
-            buf = start + end;
+            memmove(ptr + cursor - 1, ptr + cursor, length - cursor + 1);
             cursor--;
             if (slice_at > 0) slice_at--;
         }
@@ -332,27 +317,23 @@ bool TextField::update(UIContext& ctx, char key) {
         cursor = 0;
         slice_at = 0;
     } else if (key == KEY_RIGHT) {
-        if (cursor < buf.length()) cursor++;
-        if ((cursor > slice_at+window_size-2 && cursor < buf.length()-1 ||
+        if (cursor < length) cursor++;
+        if ((cursor > slice_at+window_size-2 && cursor < length-1 ||
             cursor > slice_at+window_size-1) &&
-            cursor < buf.length()) slice_at++;
+            cursor < length) slice_at++;
     } else if (key == KEY_FN_RIGHT) {
-        cursor = buf.length();
-        slice_at = window_size-1 > buf.length() ? 0 : buf.length()-window_size;
+        cursor = length;
+        slice_at = window_size-1 > length ? 0 : length-window_size;
     } else if (key == KEY_FN_BACK) {
-        String start = cursor > 0 ? buf.substring(0, cursor) : "";
-        String end = cursor+1 < buf.length() ? buf.substring(cursor+1) : "";
-        buf = start + end;
+        if (cursor < length) memmove(ptr + cursor, ptr + cursor + 1, length - cursor);
     } else if (key == KEY_SHIFT_BACK) {
-        String start = "";
-        String end = cursor < buf.length() ? buf.substring(cursor) : "";
-        buf = start + end;
+        memmove(ptr, ptr + cursor, length - cursor + 1);
         cursor = 0;
         slice_at = 0;
     } else if (key == KEY_ENTER && submittable) {
-        char copy[max_length];
-        strcpy(copy, buf.c_str());
-        buf = "";
+        char copy[max_length + 1];
+        strcpy(copy, ptr);
+        ptr[0] = '\0';
         on_submit(copy);
         cursor = 0;
         slice_at = 0;
@@ -360,7 +341,6 @@ bool TextField::update(UIContext& ctx, char key) {
         return false;
     }
 
-    strcpy(ptr, buf.c_str());
     return true;
 }
 
@@ -377,21 +357,13 @@ Color ColorInput<T>::getColor() {
 
 template <class T>
 void ColorInput<T>::render(UIContext& ctx, bool /*minimalized*/) {
-    String prefix = getLabel(ctx.availableCharsX() - 7);
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + 7);
-
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; ++i) ctx.print(' ');
+    printPrefix(ctx, 7);
     ctx.printf("#%06X", getColor().pack());
 }
 
 template <class T>
 void ColorInput<T>::renderInline(UIContext& ctx) {
-    String prefix = getLabel(ctx.availableCharsX() - 7);
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + 7);
-
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; ++i) ctx.print(' ');
+    printPrefix(ctx, 7);
     bool high = (cursor % 2 == 0);
     ctx.setTextColor(color.as565(), ctx.theme.bg);
     ctx.print('#');
@@ -399,16 +371,17 @@ void ColorInput<T>::renderInline(UIContext& ctx) {
     for (uint8_t i = 0; i < 3; ++i) {
         if (cursor/2 == i) {
             if (high) ctx.invertColors();
-            ctx.printf("%01X", color.raw[i] >> 4 & 0x0F);
+            ctx.print(hexDigit(color.raw[i] >> 4));
 
             if (high)   ctx.resetColors();
             else        ctx.invertColors();
 
-            ctx.printf("%01X", color.raw[i] & 0x0F);
+            ctx.print(hexDigit(color.raw[i]));
             ctx.resetColors();
         } else {
             ctx.resetColors();
-            ctx.printf("%02X", color.raw[i]);
+            ctx.print(hexDigit(color.raw[i] >> 4));
+            ctx.print(hexDigit(color.raw[i]));
         }
     };
     ctx.resetColors();
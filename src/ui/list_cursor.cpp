@@ -0,0 +1,36 @@
+#include "ui/list_cursor.h"
+#include "keycodes.h"
+
+/********************/
+/**** ListCursor ****/
+/********************/
+void ListCursor::clampCursor(int16_t n) {
+    if (cursor >= n) cursor = n > 0 ? n-1 : 0;
+    if (slice_at > cursor) slice_at = cursor;
+}
+
+bool ListCursor::moveCursor(UIContext& ctx, char key, int16_t n) {
+    const int16_t from = slice_at;
+    if (key == KEY_UP) {
+        if (cursor > 0) {
+            cursor--;
+            if (cursor < slice_at+1 && cursor > 0) slice_at--;
+        } else {
+            cursor = n-1;
+            slice_at = (n > window_size) ? (n - window_size) : 0;
+        }
+    } else if (key == KEY_DOWN) {
+        if (cursor < n-1) {
+            cursor++;
+            if ((cursor > slice_at+window_size-2 && cursor < n-1) ||
+                cursor > slice_at+window_size-1) slice_at++;
+        } else {
+            cursor = 0;
+            slice_at = 0;
+        }
+    } else {
+        return false;
+    }
+    ctx.scrolled(slice_at - from);
+    return true;
+}
@@ -0,0 +1,122 @@
+#include <cctype>
+#include <cstring>
+
+#include "ui/markup.h"
+#include "ui/context.h"
+
+static uint8_t hexValue(char c) {
+    return isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10);
+}
+
+/****************/
+/**** Markup ****/
+/****************/
+void Markup::parse(const char* source, TextSink text, ColorSink color) {
+    uint16_t stack[MARKUP_STACK];
+    uint8_t depth = 0;
+
+    const char* p = source;
+    while (*p) {
+        if (*p != '[') {
+            text(*p++);
+            continue;
+        }
+
+        if (p[1] == '[') {
+            text('[');
+            p += 2;
+            continue;
+        }
+
+        if (p[1] == ']') {
+            if (depth) depth--;
+            if (depth) color(stack[depth - 1], false);
+            else       color(0, true);
+            p += 2;
+            continue;
+        }
+
+        if (p[1] == '#') {
+            const char* q = p + 2;
+            uint32_t rgb = 0;
+            uint8_t digits = 0;
+            while (digits < 6 && isxdigit(*q)) {
+                rgb = rgb << 4 | hexValue(*q++);
+                digits++;
+            }
+
+            if (*q == ']') {
+                if (digits == 0) {
+                    depth = 0;
+                    color(0, true);
+                } else {
+                    uint16_t c = rgb565(rgb);
+                    if (depth == MARKUP_STACK) depth--; // deepest entry gets replaced
+                    stack[depth++] = c;
+                    color(c, false);
+                }
+                p = q + 1;
+                continue;
+            }
+        }
+
+        text(*p++); // not a tag
+    }
+}
+
+Markup::Markup(const Markup& other) {
+    *this = other;
+}
+
+Markup& Markup::operator=(const Markup& other) {
+    if (this == &other) return *this;
+
+    delete[] text;
+    delete[] spans;
+    text = nullptr;
+    spans = nullptr;
+    length = other.length;
+    count = other.count;
+    if (other.text) {
+        text = new char[length + 1];
+        memcpy(text, other.text, length + 1);
+        spans = new MarkupSpan[count];
+        memcpy(spans, other.spans, count * sizeof(MarkupSpan));
+    }
+    return *this;
+}
+
+Markup::~Markup() {
+    delete[] text;
+    delete[] spans;
+}
+
+void Markup::compile(const char* source) {
+    delete[] text;
+    delete[] spans;
+
+    // upper bounds: every character is text, every '[' starts a span
+    size_t n = strlen(source);
+    size_t brackets = 0;
+    for (const char* p = source; *p; p++) brackets += *p == '[';
+
+    text = new char[n + 1];
+    spans = new MarkupSpan[brackets + 1];
+    length = 0;
+    count = 1;
+    spans[0] = {0, 0, 0, true};
+
+    parse(source, [this](char c) {
+        text[length++] = c;
+        spans[count - 1].length++;
+    }, [this](uint16_t color, bool themed) {
+        MarkupSpan& last = spans[count - 1];
+        if (last.length == 0) {
+            last.themed = themed;
+            last.color = color;
+        } else {
+            spans[count++] = {length, 0, color, themed};
+        }
+    });
+    text[length] = '\0';
+}
@@ -1,11 +1,14 @@
+#include <algorithm>
+
 #include "ui/modals.h"
 #include "keycodes.h"
 
 const uint8_t pad_x = 3;
 const uint8_t pad_y = 2;
 
-void drawBoxed(UIContext& ctx, const String& text, int16_t& bx, int16_t& by, uint16_t& bw, uint16_t& bh) {
+void drawBoxed(UIContext& ctx, const char* text, uint8_t min_chars, int16_t& bx, int16_t& by, uint16_t& bw, uint16_t& bh) {
     ctx.display.getTextBounds(text, 0, 0, &bx, &by, &bw, &bh);
+    bw = std::max<uint16_t>(bw, min_chars * ctx.charWidth()); // blank padding, nothing to print for it
 
     uint16_t box_w = bw + pad_x*2;
     uint16_t box_h = bh + pad_y*2 + 2;
@@ -27,7 +30,7 @@ void drawBoxed(UIContext& ctx, const String& text, int16_t& bx, int16_t& by, uin
 /***************/
 void Alert::render(UIContext& ctx) {
     int16_t x, y; uint16_t bw, bh;
-    drawBoxed(ctx, message, x, y, bw, bh);
+    drawBoxed(ctx, message.c_str(), 0, x, y, bw, bh);
 }
 
 bool Alert::update(UIContext& ctx, char key) {
@@ -39,15 +42,8 @@ bool Alert::update(UIContext& ctx, char key) {
 /**** ConfirmModal ****/
 /**********************/
 void ConfirmModal::render(UIContext& ctx) {
-    String copy = message;
-    if (copy.length() < 6) {
-        for (int i = 0; i < 6 - copy.length() + 1; i++) {
-            copy += " ";
-        }
-    }
-
     int16_t x, y; uint16_t bw, bh;
-    drawBoxed(ctx, copy, x, y, bw, bh);
+    drawBoxed(ctx, message.c_str(), message.length() < 6 ? 7 : 0, x, y, bw, bh); // room for both buttons
 
 
     if (!flag) {
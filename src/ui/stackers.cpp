@@ -10,15 +10,65 @@ void MenuView::addChild(UIElement* e) {
     if (cursor > window_size+slice_at-1) slice_at++;
 }
 
+void MenuView::scrollToEnd() {
+    const int16_t n = size();
+    cursor = n > 0 ? n-1 : 0;
+    const int16_t window = std::max<int16_t>(window_size, 1);
+    if (cursor > slice_at+window-1) slice_at = cursor-window+1;
+}
+
+void MenuView::renderRow(UIContext& ctx, int16_t i) {
+    if (isVirtual()) render_row(ctx, i);
+    else children[i]->render(ctx, true);
+}
+
+bool MenuView::activate(UIContext& ctx) {
+    UIElement* element;
+    if (isVirtual()) {
+        if (!open_row) return false;
+        element = opened = open_row(cursor);
+        if (element == nullptr) { // the callback did all there was to do
+            on_exit();
+            return true;
+        }
+    } else {
+        element = children[cursor];
+    }
+
+    if (element->getType() == ElementType::CLICKABLE) {
+        static_cast<UIClickable*>(element)->activate(ctx);
+        delete opened;
+        opened = nullptr;
+        on_exit();
+    } else {
+        selected = element->enter();
+        ctx.refresh(true);
+    }
+    return true;
+}
+
+void MenuView::leaveSelected() {
+    selected = nullptr;
+    if (!isVirtual()) {
+        children[cursor]->leave();
+        return;
+    }
+    opened->leave();
+    delete opened;
+    opened = nullptr;
+}
+
 void MenuView::render(UIContext& ctx, bool minimalized) {
-    const int16_t n = children.size();
+    const int16_t n = size();
 
     if (selected == nullptr) {
         if (minimalized) {
             // TODO: maybe trim here as well
-            ctx.println(getLabel());
+            printLabel(ctx);
+            ctx.println();
         } else {
-            if (title.length()) ctx.println(title);
+            if (colorized) ctx.println(markup);
+            else if (title.length()) ctx.println(title);
 
             window_size = ctx.availableCharsY();
             const int16_t last = std::min<int16_t>(slice_at + window_size, n);
@@ -29,7 +79,7 @@ void MenuView::render(UIContext& ctx, bool minimalized) {
 
             for (int16_t i = slice_at; i < last; ++i) {
                 ctx.print(i == cursor && active ? "\x1A" : " ");
-                children[i]->render(ctx, true);
+                renderRow(ctx, i);
             }
 
             if (fill_mode == FillMode::BOTTOM && n < window_size) {
@@ -38,16 +88,17 @@ void MenuView::render(UIContext& ctx, bool minimalized) {
         }
     } else {
         if (selected->getType() == ElementType::INLINE) {
-            ctx.println(title);
+            if (colorized) ctx.println(markup);
+            else ctx.println(title);
             window_size = ctx.availableCharsY();
             const int16_t last = std::min<int16_t>(slice_at + window_size, n);
 
             for (int16_t i = slice_at; i < last; ++i) {
                 ctx.print(i == cursor && active ? "\x1A" : " ");
-                if (children[i] == selected) {
-                    static_cast<UIInline*>(children[i])->renderInline(ctx);
+                if (i == cursor) {
+                    static_cast<UIInline*>(selected)->renderInline(ctx);
                 } else {
-                    children[i]->render(ctx, true);
+                    renderRow(ctx, i);
                 }
             }
         } else {
@@ -59,48 +110,18 @@ void MenuView::render(UIContext& ctx, bool minimalized) {
 
 bool MenuView::update(UIContext& ctx, char key) {
     if (selected == nullptr) {
-        const int16_t n = children.size();
+        const int16_t n = size();
         if (key == 0 || n <= 0) return false;
+        clampCursor(n); // a virtual list may have shrunk
 
-        if (key == KEY_UP) {
-            if (cursor > 0) {
-                cursor--;
-                if (cursor < slice_at+1 && cursor > 0) slice_at--;
-            } else {
-                cursor = n-1;
-                slice_at = (n > window_size) ? (n - window_size) : 0;
-            }
-            return true;
-        }
-        if (key == KEY_DOWN) {
-            if (cursor < n-1) {
-                cursor++;
-                if ((cursor > slice_at+window_size-2 && cursor < n-1 ||
-                    cursor > slice_at+window_size-1) &&
-                    cursor < n) slice_at++;
-            } else {
-                cursor = 0;
-                slice_at = 0;
-            }
-            return true;
-        }
-        if (key == KEY_RIGHT || key == KEY_ENTER) {
-            auto element = children[cursor];
-            if (element->getType() == ElementType::CLICKABLE) {
-                static_cast<UIClickable*>(element)->activate(ctx);
-                on_exit();
-            } else {
-                selected = children[cursor];
-                ctx.refresh(true);
-            }
-            return true;
-        }
+        if (moveCursor(ctx, key, n)) return true;
+        if (key == KEY_RIGHT || key == KEY_ENTER) return activate(ctx);
     } else {
         if (selected->update(ctx, key)) return true;
 
         if (key == KEY_LEFT || key == KEY_ESC) {
             ctx.refresh(true);
-            selected = nullptr;
+            leaveSelected();
             on_exit();
             return true;
         }
@@ -110,12 +131,39 @@ bool MenuView::update(UIContext& ctx, char key) {
 }
 
 
+/******************/
+/**** LazyView ****/
+/******************/
+UIElement* LazyView::enter() {
+    if (built == nullptr) built = factory();
+    return built->enter();
+}
+
+void LazyView::leave() {
+    built->leave();
+    if (policy == SubtreePolicy::KEEP) return;
+
+    delete built;
+    built = nullptr;
+}
+
+void LazyView::render(UIContext& ctx, bool minimalized) {
+    if (built == nullptr || minimalized) {
+        printLabel(ctx);
+        ctx.println();
+        return;
+    }
+    built->render(ctx, false);
+}
+
+
 /*********************/
 /**** TabSelector ****/
 /*********************/
 void TabSelector::render(UIContext& ctx, bool minimalized) {
     if (minimalized) {
-        ctx.println(getLabel());
+        printLabel(ctx);
+        ctx.println();
     } else {
         for (int i = 0; i < children.size(); ++i) {
             auto& element = children[i];
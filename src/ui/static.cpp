@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 
 #include "ui/static.h"
 
@@ -7,7 +8,13 @@
 /***************/
 void Label::render(UIContext& ctx, bool minimalized) {
     if (max_length < 0) max_length = ctx.availableCharsX();
-    ctx.println(minimalized ? getLabel(max_length) : title);
+    if (!minimalized) {
+        if (colorized) ctx.println(markup);
+        else ctx.println(title);
+        return;
+    }
+    printLabel(ctx, max_length);
+    ctx.println();
 }
 
 /******************/
@@ -15,33 +22,28 @@ void Label::render(UIContext& ctx, bool minimalized) {
 /******************/
 template <class T>
 void Property<T>::render(UIContext& ctx, bool minimalized) {
-    String data = "";
+    char buf[16];
+    const char* data = buf;
     if (with_values && std::is_integral_v<T>) {
         if (*ptr < 0) {
-            data = values.empty() ? "<null>" : values.front();
+            data = values.empty() ? "<null>" : values.front().c_str();
         } else if (*ptr >= values.size()) {
-            data = values.back();
+            data = values.back().c_str();
         } else {
-            data = values[*ptr];
+            data = values[*ptr].c_str();
         }
     } else {
-        char buf[16];
         std::snprintf(buf, sizeof(buf), format, *ptr);
-        data = String(buf);
     }
 
     if (!minimalized) {
-        ctx.print(getLabel());
+        printLabel(ctx);
         ctx.print(": ");
         ctx.println(data);
         return;
     }
 
-    String prefix = getLabel(ctx.availableCharsX() - data.length());
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + data.length());
-
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
+    printPrefix(ctx, strlen(data));
     ctx.println(data);
 }
 
@@ -49,18 +51,15 @@ void Property<T>::render(UIContext& ctx, bool minimalized) {
 /**** StringProperty ****/
 /************************/
 void StringProperty::render(UIContext& ctx, bool minimalized) {
-    String data = ptr != nullptr ? String(ptr) : "<null>";
+    const char* data = ptr != nullptr ? ptr : "<null>";
 
     if (!minimalized) {
-        ctx.print(getLabel());
+        printLabel(ctx);
         ctx.print(": ");
         ctx.println(data);
         return;
     }
 
-    String prefix = getLabel(ctx.availableCharsX() - data.length());
-    uint8_t spaces = ctx.availableSpaces(prefix.length() + data.length());
-    ctx.print(prefix);
-    for (uint8_t i = 0; i < spaces; i++) ctx.print(' ');
+    printPrefix(ctx, strlen(data));
     ctx.println(data);
 }
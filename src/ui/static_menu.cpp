@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <cstring>
+
+#include "ui/static_menu.h"
+#include "ui/inputs.h"
+#include "keycodes.h"
+
+/********************/
+/**** StaticMenu ****/
+/********************/
+UIElement* StaticMenu::open(const MenuEntry& e) {
+    switch (e.kind) {
+        case EntryKind::SUBMENU:
+            return StaticMenu::make().table(*e.submenu).buildPtr();
+        case EntryKind::NUMBER:
+            if (e.type == ValueType::U8) {
+                return NumberPicker<uint8_t>::make().icon(e.icon).title(e.title).suffix(e.text)
+                    .pointer(static_cast<uint8_t*>(e.ptr)).min(e.min).max(e.max).buildPtr();
+            }
+            if (e.type == ValueType::I8) {
+                return NumberPicker<int8_t>::make().icon(e.icon).title(e.title).suffix(e.text)
+                    .pointer(static_cast<int8_t*>(e.ptr)).min(e.min).max(e.max).buildPtr();
+            }
+            return NumberPicker<float>::make().icon(e.icon).title(e.title).suffix(e.text)
+                .pointer(static_cast<float*>(e.ptr)).min(e.min).max(e.max)
+                .precision(e.precision).cursor(e.cursor).buildPtr();
+        case EntryKind::SELECT: {
+            auto builder = Selector::make().icon(e.icon).title(e.title).pointer(static_cast<uint8_t*>(e.ptr));
+            for (uint8_t i = 0; i < e.length; i++) builder.addItem(e.names[i]);
+            return builder.buildPtr();
+        }
+        case EntryKind::TEXT:
+            return TextField::make().icon(e.icon).title(e.title).pointer(static_cast<char*>(e.ptr)).maxLength(e.length).buildPtr();
+        case EntryKind::ELEMENT:
+            return e.factory();
+        default:
+            return nullptr;
+    }
+}
+
+void StaticMenu::formatValue(const MenuEntry& e, char* buf, size_t len) {
+    if (e.getter) {
+        e.getter(buf, len);
+        return;
+    }
+
+    if (e.kind == EntryKind::TOGGLE) {
+        snprintf(buf, len, "[%c]", *static_cast<bool*>(e.ptr) ? 'x' : ' ');
+    } else if (e.names) {
+        uint8_t i = *static_cast<uint8_t*>(e.ptr);
+        snprintf(buf, len, "%s", e.names[i < e.length ? i : e.length - 1]);
+    } else if (e.kind == EntryKind::NUMBER) {
+        switch (e.type) {
+            case ValueType::U8:     snprintf(buf, len, "%u%s", *static_cast<uint8_t*>(e.ptr), e.text); break;
+            case ValueType::I8:     snprintf(buf, len, "%d%s", *static_cast<int8_t*>(e.ptr), e.text); break;
+            default:                snprintf(buf, len, "%.*f%s", e.precision, *static_cast<float*>(e.ptr), e.text); break;
+        }
+    } else {
+        switch (e.type) {
+            case ValueType::U8:     snprintf(buf, len, e.text, *static_cast<uint8_t*>(e.ptr)); break;
+            case ValueType::I8:     snprintf(buf, len, e.text, *static_cast<int8_t*>(e.ptr)); break;
+            case ValueType::FLOAT:  snprintf(buf, len, e.text, *static_cast<float*>(e.ptr)); break;
+            case ValueType::BOOL:   snprintf(buf, len, e.text, *static_cast<bool*>(e.ptr)); break;
+            case ValueType::STR:    snprintf(buf, len, "%s", static_cast<char*>(e.ptr)); break;
+            default:                buf[0] = '\0'; break;
+        }
+    }
+}
+
+void StaticMenu::renderEntry(UIContext& ctx, const MenuEntry& e) {
+    switch (e.kind) {
+        case EntryKind::LABEL:
+        case EntryKind::SUBMENU:
+        case EntryKind::ELEMENT:
+            printLabel(ctx, e.icon, e.title, ctx.availableCharsX());
+            ctx.println();
+            return;
+        case EntryKind::ACTION: {
+            int16_t available = ctx.availableCharsX() - 2;
+            ctx.print('[');
+            printLabel(ctx, e.icon, e.title, available);
+            ctx.println(']');
+            return;
+        }
+        default:
+            break;
+    }
+
+    char value[24];
+    formatValue(e, value, sizeof(value));
+    printPrefix(ctx, e.icon, e.title, strlen(value));
+    ctx.println(value);
+}
+
+void StaticMenu::close() {
+    selected = nullptr;
+    opened->leave();
+    delete opened;
+    opened = nullptr;
+    if (table->on_exit) table->on_exit();
+}
+
+void StaticMenu::render(UIContext& ctx, bool minimalized) {
+    const int16_t n = table->count;
+
+    if (selected == nullptr && minimalized) {
+        printLabel(ctx, icon, table->title);
+        ctx.println();
+        return;
+    }
+
+    if (selected == nullptr || selected->getType() == ElementType::INLINE) {
+        if (strlen(table->title)) ctx.println(table->title);
+
+        window_size = ctx.availableCharsY();
+        const int16_t last = std::min<int16_t>(slice_at + window_size, n);
+
+        for (int16_t i = slice_at; i < last; ++i) {
+            ctx.print(i == cursor && active ? "\x1A" : " ");
+            if (i == cursor && selected) {
+                static_cast<UIInline*>(selected)->renderInline(ctx);
+            } else {
+                renderEntry(ctx, table->entries[i]);
+            }
+        }
+    } else {
+        selected->render(ctx, false);
+    }
+}
+
+bool StaticMenu::update(UIContext& ctx, char key) {
+    if (selected == nullptr) {
+        const int16_t n = table->count;
+        if (key == 0 || n <= 0) return false;
+
+        if (moveCursor(ctx, key, n)) return true;
+        if (key == KEY_RIGHT || key == KEY_ENTER) {
+            const MenuEntry& e = table->entries[cursor];
+            if (e.kind == EntryKind::TOGGLE) {
+                bool* b = static_cast<bool*>(e.ptr);
+                *b = !*b;
+                if (table->on_exit) table->on_exit();
+            } else if (e.kind == EntryKind::ACTION) {
+                e.action();
+                if (table->on_exit) table->on_exit();
+            } else {
+                opened = open(e);
+                if (opened) {
+                    selected = opened->enter();
+                    ctx.refresh(true);
+                }
+            }
+            return true;
+        }
+    } else {
+        if (selected->update(ctx, key)) return true;
+
+        if (key == KEY_LEFT || key == KEY_ESC) {
+            ctx.refresh(true);
+            close();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -1,6 +1,8 @@
 #include "utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <iterator>
 
 uint16_t Color::as565() const {
@@ -85,7 +87,7 @@ int64_t pow10i(uint8_t n) {
     return p;
 }
 
-String prettyValue(uint64_t value, const String& symbol, uint8_t precision, uint16_t per_kilo) {
+size_t prettyValue(char* buf, size_t len, uint64_t value, const char* symbol, uint8_t precision, uint16_t per_kilo) {
     static const char* prefixes[] = {"", "K", "M", "G", "T", "P"};
     uint8_t prefix_idx = 0;
     double scaled = value;
@@ -95,11 +97,13 @@ String prettyValue(uint64_t value, const String& symbol, uint8_t precision, uint
         prefix_idx++;
     }
 
-    String result{};
     precision = (scaled < 10 && prefix_idx > 0 && precision > 0) ? (precision) : 0;
-    result = String(scaled, precision);
-    result += prefixes[prefix_idx];
-    result += symbol;
+    int n = snprintf(buf, len, "%.*f%s%s", precision, scaled, prefixes[prefix_idx], symbol);
+    return n < 0 ? 0 : std::min<size_t>(n, len ? len - 1 : 0);
+}
 
-    return result;
+String prettyValue(uint64_t value, const String& symbol, uint8_t precision, uint16_t per_kilo) {
+    char buf[24];
+    prettyValue(buf, sizeof(buf), value, symbol.c_str(), precision, per_kilo);
+    return String(buf);
 }
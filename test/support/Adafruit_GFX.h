@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Arduino.h"
+#include "glcdfont.c"
+
+// Pixel-level Adafruit_GFX: the same API and the same (slow) per-pixel drawChar,
+// so the fast paths under test have something to be compared against.
+class Adafruit_GFX : public Print {
+protected:
+    const int16_t WIDTH, HEIGHT;
+    int16_t _width, _height;
+    int16_t cursor_x = 0, cursor_y = 0;
+    uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+    uint8_t textsize_x = 1, textsize_y = 1;
+    uint8_t rotation = 0;
+    bool wrap = true, _cp437 = false;
+
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void startWrite() {}
+    virtual void endWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color)   { drawPixel(x, y, color); }
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t i = x; i < x + w; i++)
+            for (int16_t j = y; j < y + h; j++) writePixel(i, j, color);
+    }
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)  { writeFillRect(x, y, 1, h, color); }
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)  { writeFillRect(x, y, w, 1, color); }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)   { writeFastVLine(x, y, h, color); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)   { writeFastHLine(x, y, w, color); }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { writeFillRect(x, y, w, h, color); }
+    virtual void fillScreen(uint16_t color)                         { fillRect(0, 0, _width, _height, color); }
+    virtual void invertDisplay(bool) {}
+    virtual void setRotation(uint8_t r) {
+        rotation = r & 3;
+        _width = rotation & 1 ? HEIGHT : WIDTH;
+        _height = rotation & 1 ? WIDTH : HEIGHT;
+    }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        int16_t dx = abs(x1 - x0), dy = -abs(y1 - y0), err = dx + dy;
+        while (true) {
+            writePixel(x0, y0, color);
+            if (x0 == x1 && y0 == y1) return;
+            int16_t e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += x0 < x1 ? 1 : -1; }
+            if (e2 <= dx) { err += dx; y0 += y0 < y1 ? 1 : -1; }
+        }
+    }
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+        int16_t stride = (w + 7) / 8;
+        for (int16_t j = 0; j < h; j++)
+            for (int16_t i = 0; i < w; i++)
+                if (bitmap[j * stride + i / 8] & (0x80 >> (i & 7))) writePixel(x + i, y + j, color);
+    }
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+        int16_t stride = (w + 7) / 8;
+        for (int16_t j = 0; j < h; j++)
+            for (int16_t i = 0; i < w; i++)
+                writePixel(x + i, y + j, bitmap[j * stride + i / 8] & (0x80 >> (i & 7)) ? color : bg);
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+        drawChar(x, y, c, color, bg, size, size);
+    }
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t sx, uint8_t sy) {
+        if (x >= _width || y >= _height || x + 6 * sx <= 0 || y + 8 * sy <= 0) return;
+        if (!_cp437 && c >= 176) c++;
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1)           writeFillRect(x + i * sx, y + j * sy, sx, sy, color);
+                else if (bg != color)   writeFillRect(x + i * sx, y + j * sy, sx, sy, bg);
+            }
+        }
+        if (bg != color) writeFillRect(x + 5 * sx, y, sx, 8 * sy, bg);
+    }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += 8 * textsize_y;
+        } else if (c != '\r') {
+            if (wrap && cursor_x + 6 * textsize_x > _width) {
+                cursor_x = 0;
+                cursor_y += 8 * textsize_y;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            cursor_x += 6 * textsize_x;
+        }
+        return 1;
+    }
+    using Print::write;
+
+    void getTextBounds(const char* text, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        uint16_t line = 0, widest = 0, lines = 1;
+        for (; *text; text++) {
+            if (*text == '\n') { lines++; line = 0; }
+            else widest = std::max<uint16_t>(widest, ++line);
+        }
+        *x1 = x;
+        *y1 = y;
+        *w = widest * 6 * textsize_x;
+        *h = lines * 8 * textsize_y;
+    }
+    void getTextBounds(const String& text, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        getTextBounds(text.c_str(), x, y, x1, y1, w, h);
+    }
+
+    void setCursor(int16_t x, int16_t y)            { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c)                   { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg)      { textcolor = c; textbgcolor = bg; }
+    void setTextSize(uint8_t s)                     { textsize_x = textsize_y = s ? s : 1; }
+    void setTextWrap(bool w)                        { wrap = w; }
+    void cp437(bool x = true)                       { _cp437 = x; }
+
+    [[nodiscard]] int16_t width() const             { return _width; }
+    [[nodiscard]] int16_t height() const            { return _height; }
+    [[nodiscard]] uint8_t getRotation() const       { return rotation; }
+    [[nodiscard]] int16_t getCursorX() const        { return cursor_x; }
+    [[nodiscard]] int16_t getCursorY() const        { return cursor_y; }
+};
+
+class GFXcanvas8 : public Adafruit_GFX {
+    uint8_t* buffer;
+public:
+    GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer(new uint8_t[w * h]()) {}
+    ~GFXcanvas8() override { delete[] buffer; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= width() || y >= height()) return;
+        int16_t t;
+        switch (rotation) {
+            case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+            case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+            case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+        }
+        buffer[x + y * WIDTH] = color;
+    }
+    [[nodiscard]] uint8_t* getBuffer() const { return buffer; }
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+    uint16_t* buffer;
+public:
+    GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer(new uint16_t[w * h]()) {}
+    ~GFXcanvas16() override { delete[] buffer; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= width() || y >= height()) return;
+        int16_t t;
+        switch (rotation) {
+            case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+            case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+            case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+        }
+        buffer[x + y * WIDTH] = color;
+    }
+    [[nodiscard]] uint16_t* getBuffer() const { return buffer; }
+};
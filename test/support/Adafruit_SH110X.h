@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+
+#define SH110X_BLACK            0
+#define SH110X_WHITE            1
+#define SH110X_INVERSE          2
+#define SH110X_SETLOWCOLUMN     0x00
+#define SH110X_SETHIGHCOLUMN    0x10
+#define SH110X_SETSTARTLINE     0x40
+#define SH110X_SETPAGEADDR      0xB0
+
+// Records what would go over the bus: data bytes and commands
+class Adafruit_I2CDevice {
+public:
+    std::vector<uint8_t> sent;
+    std::vector<uint8_t> commands;
+
+    void setSpeed(uint32_t) {}
+    [[nodiscard]] size_t maxBufferSize() const { return 32; }
+    bool write(const uint8_t* data, size_t len, bool = true, const uint8_t* = nullptr, size_t = 0) {
+        sent.insert(sent.end(), data, data + len);
+        return true;
+    }
+};
+
+// 1-bit page-organized framebuffer, like the Adafruit OLED drivers keep
+class Adafruit_GrayOLED : public Adafruit_GFX {
+protected:
+    uint8_t* buffer;
+    Adafruit_I2CDevice* i2c_dev = nullptr;
+    uint32_t i2c_preclk = 400000, i2c_postclk = 100000;
+    int16_t window_x1 = 0, window_y1 = 0, window_x2 = -1, window_y2 = -1;
+
+public:
+    Adafruit_GrayOLED(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer(new uint8_t[w * ((h + 7) / 8)]()) {}
+    ~Adafruit_GrayOLED() override { delete[] buffer; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= width() || y >= height()) return;
+        int16_t t;
+        switch (rotation) {
+            case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+            case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+            case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+        }
+        uint8_t& b = buffer[x + (y / 8) * WIDTH];
+        uint8_t bit = 1 << (y & 7);
+        if (color == SH110X_WHITE)      b |= bit;
+        else if (color == SH110X_BLACK) b &= ~bit;
+        else                            b ^= bit;
+    }
+
+    uint8_t* getBuffer()                                { return buffer; }
+    void attach(Adafruit_I2CDevice* dev)                { i2c_dev = dev; } // host only: capture what display() sends
+    void setContrast(uint8_t) {}
+    void oled_command(uint8_t c)                        { if (i2c_dev) i2c_dev->commands.push_back(c); }
+    bool oled_commandList(const uint8_t* c, uint8_t n)  { while (n--) oled_command(*c++); return true; }
+};
+
+class Adafruit_SH110X : public Adafruit_GrayOLED {
+public:
+    using Adafruit_GrayOLED::Adafruit_GrayOLED;
+    void display() {}
+};
+
+class Adafruit_SH1106G : public Adafruit_SH110X {
+public:
+    Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire* = &Wire, int8_t = -1) : Adafruit_SH110X(w, h) {}
+    bool begin(uint8_t = 0x3C, bool = true) { return true; }
+};
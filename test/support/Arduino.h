@@ -0,0 +1,34 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the portable sources use,
+// so they can be built into the native unit tests.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "WString.h"
+#include "Print.h"
+
+using std::min;
+using std::max;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+inline unsigned long micros() {
+    static const auto boot = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - boot).count();
+}
+inline unsigned long millis()               { return micros() / 1000; }
+inline void delayMicroseconds(unsigned us)  { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void delay(unsigned long ms)         { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void yield()                         { std::this_thread::yield(); }
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstring>
+
+#include "Arduino.h"
+
+class EEPROMClass {
+    uint8_t data[4096]{};
+public:
+    void begin(size_t) {}
+    bool commit()                           { return true; }
+    uint8_t read(int addr) const            { return data[addr]; }
+    void write(int addr, uint8_t v)         { data[addr] = v; }
+    template<typename T> T& get(int addr, T& t) const       { memcpy(&t, data + addr, sizeof(T)); return t; }
+    template<typename T> const T& put(int addr, const T& t) { memcpy(data + addr, &t, sizeof(T)); return t; }
+};
+inline EEPROMClass EEPROM;
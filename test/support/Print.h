@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "WString.h"
+
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*data++);
+        return n;
+    }
+    size_t write(const char* text)          { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+
+    size_t print(const char* text)          { return write(text); }
+    size_t print(const String& text)        { return write(text.c_str()); }
+    size_t print(char c)                    { return write(static_cast<uint8_t>(c)); }
+    size_t println(const char* text = "")   { return print(text) + write('\n'); }
+    size_t println(const String& text)      { return print(text) + write('\n'); }
+
+    size_t printf(const char* format, ...) {
+        char buf[128];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        return write(buf);
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+// Arduino String, only what the UI code calls. Like the real one it keeps every
+// non-default string on the heap (no small-string buffer), so the host tests
+// count the same allocations the device makes.
+class String {
+    char* buffer = nullptr;
+    unsigned len = 0;
+
+    // plain calls, which unlike new-expressions the compiler may not optimize away
+    static char* allocate(unsigned n)   { return static_cast<char*>(::operator new(n)); }
+    static void release(char* p)        { if (p) ::operator delete(p); }
+
+    void assign(const char* text, unsigned n) {
+        char* p = allocate(n + 1);
+        memcpy(p, text, n);
+        p[n] = 0;
+        release(buffer);
+        buffer = p;
+        len = n;
+    }
+    void append(const char* text, unsigned n) {
+        char* p = allocate(len + n + 1);
+        memcpy(p, c_str(), len);
+        memcpy(p + len, text, n);
+        p[len + n] = 0;
+        release(buffer);
+        buffer = p;
+        len += n;
+    }
+
+public:
+    String() = default;
+    String(const char* text)                        { assign(text ? text : "", text ? strlen(text) : 0); }
+    String(const String& o)                         { if (o.buffer) assign(o.buffer, o.len); }
+    String(String&& o) noexcept : buffer(o.buffer), len(o.len) { o.buffer = nullptr; o.len = 0; }
+    explicit String(char c)                         { assign(&c, 1); }
+    explicit String(int v)                          { format("%d", v); }
+    explicit String(unsigned v)                     { format("%u", v); }
+    explicit String(long v)                         { format("%ld", v); }
+    explicit String(unsigned long v)                { format("%lu", v); }
+    explicit String(double v, unsigned char decimals = 2) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+        assign(buf, strlen(buf));
+    }
+    ~String() { release(buffer); }
+
+    String& operator=(const String& o) {
+        if (this != &o) assign(o.c_str(), o.len);
+        return *this;
+    }
+    String& operator=(String&& o) noexcept {
+        std::swap(buffer, o.buffer);
+        std::swap(len, o.len);
+        return *this;
+    }
+
+    [[nodiscard]] unsigned length() const           { return len; }
+    [[nodiscard]] const char* c_str() const         { return buffer ? buffer : ""; }
+    [[nodiscard]] char charAt(unsigned i) const     { return i < len ? buffer[i] : 0; }
+    void setCharAt(unsigned i, char c)              { if (i < len) buffer[i] = c; }
+    [[nodiscard]] String substring(unsigned from, unsigned to = -1) const {
+        String s;
+        if (to > len) to = len;
+        if (from < to) s.assign(buffer + from, to - from);
+        return s;
+    }
+
+    String& operator+=(const String& o)             { append(o.c_str(), o.len); return *this; }
+    String& operator+=(const char* o)               { append(o, strlen(o)); return *this; }
+    String& operator+=(char c)                      { append(&c, 1); return *this; }
+    friend String operator+(String a, const String& b)  { return a += b; }
+    friend String operator+(String a, const char* b)    { return a += b; }
+    friend String operator+(String a, char b)           { return a += b; }
+    bool operator==(const String& o) const          { return strcmp(c_str(), o.c_str()) == 0; }
+    bool operator!=(const String& o) const          { return !(*this == o); }
+    char operator[](unsigned i) const               { return charAt(i); }
+    explicit operator bool() const                  { return true; } // Arduino's is false only when out of memory
+
+private:
+    template<typename T>
+    void format(const char* f, T v) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), f, v);
+        assign(buf, strlen(buf));
+    }
+};
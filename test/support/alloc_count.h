@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include "alloc_tracker.h"
+
+// Heap allocations made since it was created, malloc and new alike. env:native links
+// AllocTracker's hooks, so this only sums its counters, whatever scope the code opens.
+class AllocCount {
+    uint32_t start = total();
+
+    static uint32_t total() {
+        uint32_t n = 0;
+        for (uint8_t t = 0; t < static_cast<uint8_t>(AllocTag::COUNT); t++) {
+            n += AllocTracker::stats(static_cast<AllocTag>(t)).allocs;
+        }
+        return n;
+    }
+public:
+    [[nodiscard]] uint32_t allocs() const { return total() - start; }
+};
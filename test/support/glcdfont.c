@@ -0,0 +1,23 @@
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+// Host stand-in for the Adafruit GFX 5x7 font. The glyphs are arbitrary but dense:
+// the tests only compare renderers that read the same table. Only ' ' is blank, as
+// in the real font, since the cell cache treats a space as plain background.
+struct HostFont {
+    unsigned char bits[256 * 5];
+    constexpr HostFont() : bits{} {
+        unsigned int s = 0x2545F491;
+        for (auto& b : bits) {
+            s ^= s << 13;
+            s ^= s >> 17;
+            s ^= s << 5;
+            b = s & 0xFF;
+        }
+        for (int i = ' ' * 5; i < (' ' + 1) * 5; i++) bits[i] = 0;
+    }
+};
+static constexpr HostFont host_font{};
+static const unsigned char* const font = host_font.bits;
+
+#endif
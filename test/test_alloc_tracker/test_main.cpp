@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <unity.h>
+
+#include "alloc_tracker.h"
+
+// through a volatile pointer, so the compiler can't drop a malloc/free pair
+static void* (*volatile alloc)(size_t) = malloc;
+static void (*volatile release)(void*) = free;
+
+static AllocTag over_tag = AllocTag::COUNT;
+static uint32_t over_allocs = 0;
+
+void setUp() {
+    over_tag = AllocTag::COUNT;
+    over_allocs = 0;
+    AllocTracker::onOverBudget([](AllocTag tag, uint32_t allocs) {
+        over_tag = tag;
+        over_allocs = allocs;
+    });
+    AllocTracker::reset();
+}
+
+void tearDown() {
+    for (uint8_t t = 0; t < static_cast<uint8_t>(AllocTag::COUNT); t++) AllocTracker::budget(static_cast<AllocTag>(t), 0);
+    AllocTracker::onOverBudget(nullptr);
+}
+
+// allocations go to the innermost scope, the outer one picks up again once it closes
+void test_scopes_attribute_allocations() {
+    void* p[4];
+    {
+        AllocScope render(AllocTag::RENDER);
+        p[0] = alloc(16);
+        {
+            AllocScope keys(AllocTag::KEYS);
+            p[1] = alloc(16);
+            p[2] = alloc(16);
+            release(p[1]);
+        }
+        p[3] = alloc(16);
+        release(p[0]);
+    }
+    release(p[2]);
+    release(p[3]);
+
+    const AllocStats& render = AllocTracker::stats(AllocTag::RENDER);
+    const AllocStats& keys = AllocTracker::stats(AllocTag::KEYS);
+    TEST_ASSERT_EQUAL(2, render.allocs);
+    TEST_ASSERT_EQUAL(1, render.frees);
+    TEST_ASSERT_EQUAL(1, render.scopes);
+    TEST_ASSERT_EQUAL(2, render.worst);
+    TEST_ASSERT_GREATER_OR_EQUAL(32, render.bytes);
+    TEST_ASSERT_EQUAL(2, keys.allocs);
+    TEST_ASSERT_EQUAL(1, keys.frees);
+    TEST_ASSERT_EQUAL(1, keys.scopes);
+    TEST_ASSERT_EQUAL(0, AllocTracker::stats(AllocTag::RX).allocs);
+}
+
+// worst is per scope, not the sum over all of them
+void test_worst_scope() {
+    for (int n = 1; n <= 3; n++) {
+        AllocScope rx(AllocTag::RX);
+        for (int i = 0; i < n; i++) release(alloc(8));
+    }
+    const AllocStats& rx = AllocTracker::stats(AllocTag::RX);
+    TEST_ASSERT_EQUAL(6, rx.allocs);
+    TEST_ASSERT_EQUAL(6, rx.frees);
+    TEST_ASSERT_EQUAL(3, rx.scopes);
+    TEST_ASSERT_EQUAL(3, rx.worst);
+}
+
+void test_budget_overrun_calls_back() {
+    AllocTracker::budget(AllocTag::TX, 2);
+    AllocTracker::reset(); // keeps the budget
+    {
+        AllocScope tx(AllocTag::TX);
+        release(alloc(8));
+        release(alloc(8));
+    }
+    TEST_ASSERT_EQUAL(0, AllocTracker::stats(AllocTag::TX).overruns);
+    TEST_ASSERT_TRUE(over_tag == AllocTag::COUNT);
+
+    {
+        AllocScope tx(AllocTag::TX);
+        for (int i = 0; i < 3; i++) release(alloc(8));
+    }
+    TEST_ASSERT_EQUAL(2, AllocTracker::stats(AllocTag::TX).budget);
+    TEST_ASSERT_EQUAL(1, AllocTracker::stats(AllocTag::TX).overruns);
+    TEST_ASSERT_TRUE(over_tag == AllocTag::TX);
+    TEST_ASSERT_EQUAL(3, over_allocs);
+}
+
+// peak is the heap growth inside the scope, live bytes come back once it's all freed
+void test_live_and_peak_bytes() {
+    uint32_t live = AllocTracker::liveBytes();
+    {
+        AllocScope render(AllocTag::RENDER);
+        void* a = alloc(1000);
+        void* b = alloc(1000);
+        release(a);
+        void* c = realloc(b, 4000);
+        release(c);
+    }
+    const AllocStats& render = AllocTracker::stats(AllocTag::RENDER);
+    TEST_ASSERT_EQUAL(live, AllocTracker::liveBytes());
+    TEST_ASSERT_EQUAL(3, render.allocs); // realloc counts as a free and an allocation
+    TEST_ASSERT_EQUAL(3, render.frees);
+    TEST_ASSERT_GREATER_OR_EQUAL(4000, render.peak);
+    TEST_ASSERT_LESS_THAN(6000, render.peak);
+    TEST_ASSERT_GREATER_OR_EQUAL(live + render.peak, AllocTracker::peakBytes());
+}
+
+// a `new` is charged to the line that called it, not to operator new
+void test_sites_point_at_the_caller() {
+    for (int i = 0; i < 20; i++) {
+        int* volatile p = new int[8];
+        delete[] p;
+    }
+    for (int i = 0; i < 5; i++) {
+        int* volatile p = new int[8];
+        delete[] p;
+    }
+    AllocSite top[3];
+    TEST_ASSERT_EQUAL(2, AllocTracker::topSites(top, 3));
+    TEST_ASSERT_EQUAL(20, top[0].count);
+    TEST_ASSERT_EQUAL(5, top[1].count);
+    TEST_ASSERT_GREATER_OR_EQUAL(20 * 8 * sizeof(int), top[0].bytes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scopes_attribute_allocations);
+    RUN_TEST(test_worst_scope);
+    RUN_TEST(test_budget_overrun_calls_back);
+    RUN_TEST(test_live_and_peak_bytes);
+    RUN_TEST(test_sites_point_at_the_caller);
+    return UNITY_END();
+}
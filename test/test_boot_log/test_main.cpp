@@ -0,0 +1,34 @@
+#include <unity.h>
+
+#include "boot_log.h"
+
+static BootLog boot;
+
+void setUp() { boot = BootLog{}; }
+void tearDown() {}
+
+void test_stages_keep_order_and_deltas() {
+    boot.mark("init", 100);
+    boot.mark("settings", 350);
+    boot.mark("display", 1350);
+
+    TEST_ASSERT_EQUAL(3, boot.stages());
+    TEST_ASSERT_EQUAL_STRING("settings", boot.name(1));
+    TEST_ASSERT_EQUAL(1350, boot.at(2));
+    TEST_ASSERT_EQUAL(100, boot.took(0));   // since reset
+    TEST_ASSERT_EQUAL(250, boot.took(1));
+    TEST_ASSERT_EQUAL(1000, boot.took(2));
+}
+
+void test_extra_stages_are_dropped() {
+    for (uint32_t i = 0; i < BOOT_STAGES + 4; i++) boot.mark("stage", i);
+    TEST_ASSERT_EQUAL(BOOT_STAGES, boot.stages());
+    TEST_ASSERT_EQUAL(BOOT_STAGES - 1, boot.at(BOOT_STAGES - 1));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_stages_keep_order_and_deltas);
+    RUN_TEST(test_extra_stages_are_dropped);
+    return UNITY_END();
+}
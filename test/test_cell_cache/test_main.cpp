@@ -0,0 +1,148 @@
+#include <unity.h>
+
+#include "configuration.h"
+#include "keycodes.h"
+#include "ui/base.h"
+#include "ui/inputs.h"
+#include "ui/modals.h"
+#include "ui/stackers.h"
+#include "ui/static.h"
+#include "ui/static_menu.h"
+
+#define BUFFER_BYTES (128 * 64 / 8)
+
+static uint8_t number = 5, selected = 1;
+static bool toggled = false, confirmed = false;
+static float level = 1.5f;
+static char text[12] = "hello";
+static char name[12] = "ab";
+
+static const char* const levels[] = {"Low", "Mid", "High"};
+static constexpr MenuEntry entries[] = {
+    MenuEntry::toggle('*', "Toggle", &toggled),
+    MenuEntry::number('#', "Number", &number, 0, 200, "dB"),
+    MenuEntry::number('#', "A very long float title", &level, 0, 10, 2),
+    MenuEntry::select('>', "Select", &selected, levels),
+    MenuEntry::textField('T', "Text", text, 11),
+    MenuEntry::value("Value", &number, "%u"),
+    MenuEntry::label("Label one"),
+    MenuEntry::label("Label two"),
+    MenuEntry::label("Label three"),
+    MenuEntry::button('!', "Apply all of these", nullptr),
+};
+static constexpr MenuTable table = MenuTable::of('M', "Static", entries);
+
+// more rows than the screen, so both menus scroll
+static UIElement* buildTree() {
+    return MenuView::make().title("Menu").children({
+        Label::make().title("A fairly long label text here").buildPtr(),
+        NumberPicker<uint8_t>::make().title("Num").pointer(&number).min(0).max(200).suffix("%").buildPtr(),
+        NumberPicker<float>::make().title("Flt").pointer(&level).min(0).max(10).precision(2).buildPtr(),
+        Toggle::make().title("Tog").pointer(&toggled).buildPtr(),
+        Selector::make().title("Sel").pointer(&selected).items({"one", "two", "three"}).buildPtr(),
+        TextField::make().title("Name").pointer(name).maxLength(11).buildPtr(),
+        Label::make().title("Filler 1").buildPtr(),
+        Label::make().title("Filler 2").buildPtr(),
+        Label::make().title("Filler 3").buildPtr(),
+        StaticMenu::make().table(table).buildPtr(),
+    }).buildPtr();
+}
+
+static DisplayType screen(128, 64, nullptr, -1);
+static DisplayType reference(128, 64, nullptr, -1);
+static UIContext ctx(screen);
+static UIApp* app = nullptr;
+static int partial_frames = 0;
+
+// after every key, what the cell cache left on screen must be what a full render draws
+static void press(char key) {
+    if (key) app->update(ctx, key);
+
+    uint32_t phase;
+    do { // a text cursor blinks with the clock, both frames have to see the same phase
+        phase = millis() / 500;
+        ctx.render(*app);
+        UIContext fresh(reference);
+        fresh.render(*app);
+    } while (phase != millis() / 500);
+
+    const UIRect& damage = ctx.damage();
+    if (damage.w < 128 || damage.h < 64) partial_frames++;
+    TEST_ASSERT_EQUAL_MEMORY(reference.getBuffer(), screen.getBuffer(), BUFFER_BYTES);
+}
+
+static void press(char key, int times) {
+    for (int i = 0; i < times; i++) press(key);
+}
+
+void setUp() {
+    app = UIApp::make().title("Cells").root(buildTree()).buildPtr();
+    partial_frames = 0;
+    press(0);
+}
+
+void tearDown() {
+    delete app; // UIApp doesn't own its root, the tree is left behind
+}
+
+void test_scrolling() {
+    press(KEY_DOWN, 12); // past the bottom of the screen
+    press(KEY_UP, 12);
+    TEST_ASSERT_GREATER_THAN(10, partial_frames);
+}
+
+void test_editing() {
+    press(KEY_DOWN);
+    press(KEY_ENTER); // number picker
+    press(KEY_UP, 3);
+    press(KEY_LEFT);
+    press(KEY_DOWN);
+    press(KEY_ESC);
+    TEST_ASSERT_EQUAL(7, number);
+
+    press(KEY_DOWN, 4);
+    press(KEY_ENTER); // text field
+    for (char c : "xyz") if (c) press(c);
+    press(KEY_LEFT, 2);
+    press(KEY_BACK);
+    press(KEY_ESC);
+    TEST_ASSERT_EQUAL_STRING("abyz", name);
+
+    press(KEY_DOWN, 4);
+    press(KEY_ENTER); // the static menu
+    press(KEY_DOWN, 9);
+    press(KEY_UP, 8);
+    press(KEY_ENTER); // its number
+    press(KEY_DOWN);
+    press(KEY_ESC);
+    press(KEY_UP);
+    press(KEY_ENTER); // its toggle
+    press(KEY_ESC);
+    TEST_ASSERT_EQUAL(6, number);
+    TEST_ASSERT_TRUE(toggled);
+}
+
+void test_modals_open_and_close() {
+    press(KEY_DOWN, 3);
+    app->addModal(Alert::make().message("Saved").buildPtr());
+    press(0);
+    press(KEY_DOWN); // swallowed by the alert
+    press(KEY_ENTER);
+    TEST_ASSERT_FALSE(app->hasModals());
+
+    app->addModal(ConfirmModal::make().message("Erase everything?").onConfirm([] { confirmed = true; }).buildPtr());
+    press(0);
+    press(KEY_TAB);
+    press(KEY_ENTER);
+    TEST_ASSERT_TRUE(confirmed);
+    press(KEY_DOWN);
+    press(KEY_UP);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scrolling);
+    RUN_TEST(test_editing);
+    RUN_TEST(test_modals_open_and_close);
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <unity.h>
+
+#include "network/channels.h"
+
+#define BAND_START  863.0f
+#define BAND_END    870.0f
+#define CONTROL     868.0f
+#define FRAMES      10000
+
+static ChannelPlan a, b;
+
+void setUp() {
+    a = ChannelPlan{};
+    b = ChannelPlan{};
+}
+
+void tearDown() {}
+
+void test_same_key_same_plan() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    b.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+
+    TEST_ASSERT_EQUAL(a.id(), b.id());
+    for (uint32_t f = 0; f < FRAMES; f++) TEST_ASSERT_EQUAL(a.hop(f), b.hop(f));
+}
+
+// the case a channel count check let through: both plans have the same channels, in another order
+void test_different_key_different_plan() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    b.configure(BAND_START, BAND_END, 125, CONTROL, 98765);
+
+    TEST_ASSERT_EQUAL(a.channels(), b.channels());
+    TEST_ASSERT_NOT_EQUAL(a.id(), b.id());
+
+    uint32_t same = 0;
+    for (uint32_t f = 0; f < FRAMES; f++) same += a.hop(f) == b.hop(f);
+    TEST_ASSERT_LESS_THAN(FRAMES / 4, same);
+}
+
+void test_other_bandwidth_different_plan() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    b.configure(BAND_START, BAND_END, 250, CONTROL, 1234);
+    TEST_ASSERT_NOT_EQUAL(a.id(), b.id());
+}
+
+void test_cleared_plan_has_no_id() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    TEST_ASSERT_NOT_EQUAL(0, a.id());
+    a.clear();
+    TEST_ASSERT_EQUAL(0, a.id());
+    TEST_ASSERT_EQUAL(CHANNEL_NONE, a.hop(0));
+}
+
+// a node only takes the busy mask of a coordinator on its own plan; on a foreign one it stays put
+void test_adopt_checks_the_plan() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    b.configure(BAND_START, BAND_END, 125, CONTROL, 98765);
+
+    a.adopt(b.id(), 0);
+    for (uint32_t f = 0; f < 100; f++) TEST_ASSERT_EQUAL(CHANNEL_NONE, a.hop(f));
+
+    a.adopt(a.id(), 1UL << 3);
+    TEST_ASSERT_EQUAL_HEX32(1UL << 3, a.busyMask());
+    for (uint32_t f = 0; f < 100; f++) {
+        TEST_ASSERT_NOT_EQUAL(CHANNEL_NONE, a.hop(f));
+        TEST_ASSERT_NOT_EQUAL(3, a.hop(f));
+    }
+}
+
+void test_control_channel_is_never_hopped_to() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    for (uint32_t f = 0; f < FRAMES; f++) {
+        uint8_t ch = a.hop(f);
+        TEST_ASSERT_TRUE(ch < a.channels());
+        TEST_ASSERT_TRUE(a.frequency(ch) - CONTROL >= 0.125f || CONTROL - a.frequency(ch) >= 0.125f);
+    }
+}
+
+void test_busy_channels_are_skipped() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    for (int i = 0; i < 50; i++) {
+        a.sample(5, true);
+        a.sample(6, false);
+    }
+    a.updateMask();
+    TEST_ASSERT_EQUAL_HEX32(0, a.busyMask()); // not before it is announced
+    a.announce();
+
+    TEST_ASSERT_EQUAL_HEX32(1UL << 5, a.busyMask());
+    for (uint32_t f = 0; f < FRAMES; f++) TEST_ASSERT_NOT_EQUAL(5, a.hop(f));
+}
+
+void test_at_most_half_the_band_is_masked() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    for (int i = 0; i < 50; i++) {
+        for (uint8_t ch = 0; ch < a.channels(); ch++) a.sample(ch, true);
+    }
+    a.updateMask();
+    a.announce();
+
+    TEST_ASSERT_EQUAL(a.channels() / 2, __builtin_popcount(a.busyMask()));
+    TEST_ASSERT_NOT_EQUAL(CHANNEL_NONE, a.hop(0));
+}
+
+// the coordinator samples right after its beacon; a changed mask must wait for the next
+// beacon, or it hops the rest of the frame on channels the nodes don't know about
+void test_mask_changes_apply_at_the_beacon() {
+    a.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+    b.configure(BAND_START, BAND_END, 125, CONTROL, 1234);
+
+    uint32_t changes = 0, last = 0;
+    for (uint32_t f = 0; f < 2000; f++) {
+        b.adopt(a.id(), a.announce()); // beacon
+        TEST_ASSERT_EQUAL(a.hop(f), b.hop(f));
+
+        uint8_t ch = f % a.channels();
+        bool loud = (f / 200) % 2 ? ch % 3 == 0 : ch % 4 == 1; // occupancy moves around
+        for (int i = 0; i < 3; i++) a.sample(ch, loud);
+        a.updateMask();
+        TEST_ASSERT_EQUAL(a.hop(f), b.hop(f)); // rest of the frame
+
+        changes += a.nextMask() != last;
+        last = a.nextMask();
+    }
+    TEST_ASSERT_GREATER_THAN(4, changes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_same_key_same_plan);
+    RUN_TEST(test_different_key_different_plan);
+    RUN_TEST(test_other_bandwidth_different_plan);
+    RUN_TEST(test_cleared_plan_has_no_id);
+    RUN_TEST(test_adopt_checks_the_plan);
+    RUN_TEST(test_control_channel_is_never_hopped_to);
+    RUN_TEST(test_busy_channels_are_skipped);
+    RUN_TEST(test_at_most_half_the_band_is_masked);
+    RUN_TEST(test_mask_changes_apply_at_the_beacon);
+    return UNITY_END();
+}
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <cstring>
+#include <unity.h>
+
+#include "cores.h"
+#include "network/link.h"
+
+#define FRAMES  200000
+
+static CoreLink link;
+static std::atomic<uint32_t> calls{0};
+
+// the radio side as main.cpp runs it: echo SENDs, run CALLs, reply when asked to
+static void radioSetup() {}
+static void radioLoop() {
+    LinkFrame f;
+    while (link.fromUi(f)) {
+        if (f.op == LinkOp::SEND) {
+            f.op = LinkOp::SENT;
+            f.status = static_cast<int16_t>(f.len);
+        } else if (f.op == LinkOp::CALL) {
+            f.status = f.fn();
+            if (!f.done) continue;
+            f.op = LinkOp::REPLY;
+        }
+        while (!link.toUi(f)) wakeCores(); // the UI side drains it
+    }
+    wakeCores();
+}
+
+void setUp() {}
+
+void tearDown() {
+    stopRadioCore();
+    LinkFrame f;
+    while (link.fromUi(f)) {}   // a failed test leaves frames behind
+    while (link.fromRadio(f)) {}
+}
+
+// nothing drains the radio side: the UI sees a full queue instead of blocking
+void test_queue_is_bounded() {
+    LinkFrame f;
+    f.op = LinkOp::SEND;
+    for (uint32_t i = 0; i < LINK_QUEUE_SIZE; i++) {
+        f.assign(&i, sizeof(i));
+        TEST_ASSERT_TRUE(link.toRadio(f));
+    }
+    TEST_ASSERT_FALSE(link.toRadio(f));
+
+    for (uint32_t i = 0; i < LINK_QUEUE_SIZE; i++) {
+        uint32_t seq;
+        TEST_ASSERT_TRUE(link.fromUi(f));
+        memcpy(&seq, f.data, sizeof(seq));
+        TEST_ASSERT_EQUAL(i, seq);
+    }
+    TEST_ASSERT_FALSE(link.fromUi(f));
+}
+
+// every frame comes back once, in order and intact, while both sides run flat out
+void test_frames_cross_cores_in_order() {
+    startRadioCore(radioSetup, radioLoop);
+
+    uint32_t sent = 0, received = 0;
+    while (received < FRAMES) {
+        if (sent < FRAMES) {
+            LinkFrame f;
+            f.op = LinkOp::SEND;
+            uint8_t payload[LINK_FRAME_MAX];
+            uint8_t len = 4 + sent % (LINK_FRAME_MAX - 4);
+            memcpy(payload, &sent, sizeof(sent));
+            for (uint8_t i = 4; i < len; i++) payload[i] = static_cast<uint8_t>(sent + i);
+            f.assign(payload, len);
+            if (link.toRadio(f)) sent++;
+        }
+
+        LinkFrame r;
+        bool idle = true;
+        while (link.fromRadio(r)) {
+            idle = false;
+            uint32_t seq;
+            memcpy(&seq, r.data, sizeof(seq));
+            TEST_ASSERT_EQUAL(received, seq);
+            TEST_ASSERT_TRUE(r.op == LinkOp::SENT);
+            TEST_ASSERT_EQUAL(4 + seq % (LINK_FRAME_MAX - 4), r.len);
+            TEST_ASSERT_EQUAL(r.len, r.status);
+            if (r.len > 4) TEST_ASSERT_EQUAL(static_cast<uint8_t>(seq + r.len - 1), r.data[r.len - 1]);
+            received++;
+        }
+        if (idle) wakeCores();
+    }
+
+    stopRadioCore();
+    TEST_ASSERT_EQUAL(0, link.lostFrames());
+}
+
+// CALLs run on the radio side; replies carry the result back to the done callback
+void test_calls_reply_on_the_ui_side() {
+    startRadioCore(radioSetup, radioLoop);
+
+    uint32_t posted = 0, replies = 0;
+    int16_t last = -1;
+    while (replies < 1000) {
+        if (posted < 1000) {
+            LinkFrame f;
+            f.op = LinkOp::CALL;
+            f.fn = []() -> int16_t { return static_cast<int16_t>(calls.fetch_add(1)); };
+            f.done = [](int16_t) {};
+            if (link.toRadio(f)) posted++;
+        }
+
+        LinkFrame r;
+        while (link.fromRadio(r)) {
+            TEST_ASSERT_TRUE(r.op == LinkOp::REPLY);
+            TEST_ASSERT_EQUAL(last + 1, r.status);
+            last = r.status;
+            r.done(r.status);
+            replies++;
+        }
+    }
+
+    stopRadioCore();
+    TEST_ASSERT_EQUAL(1000, calls.load());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_queue_is_bounded);
+    RUN_TEST(test_frames_cross_cores_in_order);
+    RUN_TEST(test_calls_reply_on_the_ui_side);
+    return UNITY_END();
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <Adafruit_SH110X.h>
+#include <unity.h>
+
+#include "displays/glyph_blitter.h"
+
+#define SCREENS 500 // per benchmark run
+
+// the slow path drawChar() takes, pixel by pixel through the rotation
+struct Mono : Adafruit_GrayOLED {
+    Mono() : Adafruit_GrayOLED(128, 64) { cp437(true); }
+    void draw(int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg) { drawChar(x, y, c, fg, bg, 1); }
+};
+
+struct Color : GFXcanvas16 {
+    Color() : GFXcanvas16(128, 128) { cp437(true); }
+    void draw(int16_t x, int16_t y, uint8_t c, uint16_t fg, uint16_t bg) { drawChar(x, y, c, fg, bg, 1); }
+};
+
+void setUp() { srand(1); }
+void tearDown() {}
+
+void test_pages_match_draw_char() {
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        Mono ref, fast;
+        ref.setRotation(rotation);
+        fast.setRotation(rotation);
+
+        for (int i = 0; i < 4000; i++) {
+            int16_t x = rand() % (ref.width() - 5), y = rand() % (ref.height() - 7);
+            uint8_t c = rand();
+            uint16_t fg = rand() & 1, bg = rand() % 3 ? !fg : fg;
+
+            ref.draw(x, y, c, fg, bg);
+            if (!GlyphBlitter::pages(fast.getBuffer(), 128, 64, rotation, x, y, c, fg, bg)) fast.draw(x, y, c, fg, bg);
+        }
+        TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), fast.getBuffer(), 128 * 64 / 8);
+    }
+}
+
+void test_pages_takes_cells_on_screen() {
+    Mono m;
+    TEST_ASSERT_TRUE(GlyphBlitter::pages(m.getBuffer(), 128, 64, 0, 0, 0, 'A', 1, 0));
+    TEST_ASSERT_TRUE(GlyphBlitter::pages(m.getBuffer(), 128, 64, 0, 122, 56, 'A', 1, 0));
+    TEST_ASSERT_FALSE(GlyphBlitter::pages(m.getBuffer(), 128, 64, 0, 123, 0, 'A', 1, 0));
+    TEST_ASSERT_FALSE(GlyphBlitter::pages(m.getBuffer(), 128, 64, 0, -1, 0, 'A', 1, 0));
+}
+
+void test_rgb565_matches_draw_char() {
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        Color ref, fast;
+        ref.setRotation(rotation);
+        fast.setRotation(rotation);
+
+        for (int i = 0; i < 4000; i++) {
+            int16_t x = rand() % 128 - 3, y = rand() % 128 - 3; // some partly off screen
+            uint8_t c = rand();
+            uint16_t fg = rand(), bg = rand() % 3 ? rand() : fg;
+
+            ref.draw(x, y, c, fg, bg);
+            if (!GlyphBlitter::rgb565(fast.getBuffer(), 128, 128, rotation, x, y, c, fg, bg)) fast.draw(x, y, c, fg, bg);
+        }
+        TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), fast.getBuffer(), 128 * 128 * sizeof(uint16_t));
+    }
+}
+
+template<typename F>
+static double usPerScreen(F redraw) {
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < SCREENS; n++) redraw(n);
+    std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+    return took.count() / SCREENS;
+}
+
+// full screen of 6x8 cells: 21x8 on the 128x64 panels, 21x16 on the 128x128 canvas
+void test_full_screen_redraw_benchmark() {
+    Mono mono;
+    Color color;
+
+    double mono_draw = usPerScreen([&](int n) {
+        for (int y = 0; y < 8; y++) for (int x = 0; x < 21; x++) mono.draw(x * 6, y * 8, n + x + y, 1, 0);
+    });
+    double mono_blit = usPerScreen([&](int n) {
+        for (int y = 0; y < 8; y++) for (int x = 0; x < 21; x++)
+            GlyphBlitter::pages(mono.getBuffer(), 128, 64, 0, x * 6, y * 8, n + x + y, 1, 0);
+    });
+    double color_draw = usPerScreen([&](int n) {
+        for (int y = 0; y < 16; y++) for (int x = 0; x < 21; x++) color.draw(x * 6, y * 8, n + x + y, 0x1FF1, 0);
+    });
+    double color_blit = usPerScreen([&](int n) {
+        for (int y = 0; y < 16; y++) for (int x = 0; x < 21; x++)
+            GlyphBlitter::rgb565(color.getBuffer(), 128, 128, 0, x * 6, y * 8, n + x + y, 0x1FF1, 0);
+    });
+    double rotated_blit = usPerScreen([&](int n) {
+        for (int y = 0; y < 16; y++) for (int x = 0; x < 21; x++)
+            GlyphBlitter::rgb565(color.getBuffer(), 128, 128, 1, x * 6, y * 8, n + x + y, 0x1FF1, 0);
+    });
+
+    char line[96];
+    snprintf(line, sizeof(line), "1-bit 128x64:   drawChar %7.2f us, blitter %7.2f us", mono_draw, mono_blit);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "RGB565 128x128: drawChar %7.2f us, blitter %7.2f us, %7.2f us at 90 deg",
+             color_draw, color_blit, rotated_blit);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_THAN(mono_draw, mono_blit);
+    TEST_ASSERT_LESS_THAN(color_draw, color_blit);
+    TEST_ASSERT_LESS_THAN(color_draw, rotated_blit);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pages_match_draw_char);
+    RUN_TEST(test_pages_takes_cells_on_screen);
+    RUN_TEST(test_rgb565_matches_draw_char);
+    RUN_TEST(test_full_screen_redraw_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,50 @@
+#include <cstring>
+#include <alloc_count.h>
+#include <unity.h>
+
+#include "ui/glyph_cache.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_nothing_allocated_until_used() {
+    AllocCount count;
+    GlyphCache* cache = new GlyphCache;
+    TEST_ASSERT_EQUAL(1, count.allocs()); // the object itself, no pool
+    TEST_ASSERT_LESS_THAN(32, sizeof(GlyphCache));
+
+    TEST_ASSERT_NOT_NULL(cache->get('A', 12, 16));
+    uint32_t after_first = count.allocs();
+    TEST_ASSERT_NOT_NULL(cache->get('B', 12, 16));
+    TEST_ASSERT_NOT_NULL(cache->get('A', 12, 16));
+    TEST_ASSERT_EQUAL(after_first, count.allocs()); // pool reused
+    delete cache;
+}
+
+void test_too_large_for_the_pool() {
+    AllocCount count;
+    GlyphCache cache;
+    TEST_ASSERT_NULL(cache.get('A', 255, 255));
+    TEST_ASSERT_EQUAL(0, count.allocs());
+}
+
+// more glyphs than slots: evicted ones come back with the same bits
+void test_eviction_keeps_glyphs_intact() {
+    GlyphCache cache;
+    const uint8_t w = 12, h = 16, size = (w + 7) / 8 * h;
+    uint8_t first[size];
+    memcpy(first, cache.get('A', w, h), size);
+
+    for (int c = 0; c < GLYPH_CACHE_SLOTS * 2; c++) {
+        TEST_ASSERT_NOT_NULL(cache.get(static_cast<uint8_t>('!' + c), w, h));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(first, cache.get('A', w, h), size);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_allocated_until_used);
+    RUN_TEST(test_too_large_for_the_pool);
+    RUN_TEST(test_eviction_keeps_glyphs_intact);
+    return UNITY_END();
+}
@@ -0,0 +1,48 @@
+#include <string>
+#include <unity.h>
+
+#include "ui/context.h"
+#include "ui/markup.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_tags_are_stripped() {
+    Markup m("[#ff0000]red[] [[plain[#] [x");
+    TEST_ASSERT_EQUAL_STRING("red [plain [x", m.plain());
+    TEST_ASSERT_EQUAL(13, m.plainLength());
+    TEST_ASSERT_EQUAL(3, m.spanCount()); // "red", " [plain", " [x"
+    TEST_ASSERT_FALSE(m.span(0).themed);
+    TEST_ASSERT_EQUAL(rgb565(0xff0000), m.span(0).color);
+    TEST_ASSERT_TRUE(m.span(1).themed);
+    TEST_ASSERT_EQUAL(7, m.span(1).length);
+    TEST_ASSERT_TRUE(m.span(2).themed);
+}
+
+// a long colored row has more runs than a uint8_t can count
+void test_many_spans() {
+    std::string source;
+    for (int i = 0; i < 400; i++) source += i & 1 ? "[#00ff00]x" : "[#0000ff]y";
+    Markup m(source.c_str());
+
+    TEST_ASSERT_EQUAL(400, m.plainLength());
+    TEST_ASSERT_EQUAL(400, m.spanCount());
+    uint16_t covered = 0;
+    for (uint16_t i = 0; i < m.spanCount(); i++) {
+        TEST_ASSERT_EQUAL(covered, m.span(i).offset);
+        TEST_ASSERT_EQUAL(i & 1 ? rgb565(0x00ff00) : rgb565(0x0000ff), m.span(i).color);
+        covered += m.span(i).length;
+    }
+    TEST_ASSERT_EQUAL(400, covered);
+
+    Markup copy = m;
+    TEST_ASSERT_EQUAL(400, copy.spanCount());
+    TEST_ASSERT_EQUAL(m.span(399).offset, copy.span(399).offset);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tags_are_stripped);
+    RUN_TEST(test_many_spans);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+#include <cstdlib>
+#include <cstring>
+#include <unity.h>
+
+#include "displays/page_flusher.h"
+
+#define WIDTH   128
+#define PAGES   8
+
+// Panel RAM as the controller keeps it: what the sink wrote, shown from the start page on
+struct Panel {
+    uint8_t ram[PAGES][WIDTH];
+    uint8_t start = 0;
+    uint32_t bytes = 0;
+
+    Panel() { memset(ram, 0xA5, sizeof(ram)); } // power-on garbage
+
+    PageFlusher::Sink sink() {
+        return [this](uint8_t page, uint8_t col, const uint8_t* data, uint8_t len) {
+            TEST_ASSERT_LESS_THAN(PAGES, page);
+            TEST_ASSERT_LESS_OR_EQUAL(WIDTH, col + len);
+            memcpy(&ram[page][col], data, len);
+            bytes += len;
+        };
+    }
+
+    [[nodiscard]] bool shows(const uint8_t* frame) const {
+        for (uint8_t p = 0; p < PAGES; p++) {
+            if (memcmp(ram[(p + start) % PAGES], frame + p * WIDTH, WIDTH) != 0) return false;
+        }
+        return true;
+    }
+};
+
+static uint8_t frame[PAGES * WIDTH];
+
+static void randomize(uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) data[i] = rand();
+}
+
+// one frame-to-frame change the UI typically makes
+static void edit() {
+    switch (rand() % 4) {
+        case 0: // a few scattered bytes, e.g. a blinking cursor
+            for (int n = rand() % 20; n > 0; n--) frame[rand() % sizeof(frame)] = rand();
+            break;
+        case 1: { // one glyph cell
+            int p = rand() % PAGES, c = rand() % (WIDTH - 6);
+            for (int i = 0; i < 6; i++) frame[p * WIDTH + c + i] ^= 0xFF;
+            break;
+        }
+        case 2: // a whole text row
+            randomize(frame + rand() % PAGES * WIDTH, WIDTH);
+            break;
+        default: // nothing
+            break;
+    }
+}
+
+void setUp() {
+    srand(1);
+    randomize(frame, sizeof(frame));
+}
+
+void tearDown() {}
+
+void test_first_flush_sends_everything() {
+    PageFlusher flusher(WIDTH, PAGES * 8);
+    Panel panel;
+
+    TEST_ASSERT_EQUAL(sizeof(frame), flusher.flush(frame, panel.sink()));
+    TEST_ASSERT_TRUE(panel.shows(frame));
+}
+
+void test_unchanged_frame_sends_nothing() {
+    PageFlusher flusher(WIDTH, PAGES * 8);
+    Panel panel;
+    flusher.flush(frame, panel.sink());
+
+    TEST_ASSERT_EQUAL(0, flusher.flush(frame, panel.sink()));
+}
+
+void test_invalidate_sends_everything_again() {
+    PageFlusher flusher(WIDTH, PAGES * 8);
+    Panel panel;
+    flusher.flush(frame, panel.sink());
+
+    flusher.invalidate();
+    memset(panel.ram, 0, sizeof(panel.ram)); // e.g. the panel was reset
+    TEST_ASSERT_EQUAL(sizeof(frame), flusher.flush(frame, panel.sink()));
+    TEST_ASSERT_TRUE(panel.shows(frame));
+}
+
+// the panel fed with the changed runs must end up with what a full flush writes
+void test_partial_matches_full_flush() {
+    PageFlusher partial(WIDTH, PAGES * 8), full(WIDTH, PAGES * 8);
+    Panel a, b;
+
+    for (int i = 0; i < 2000; i++) {
+        if (i) edit();
+        if (rand() % 100 == 0) partial.invalidate();
+
+        full.invalidate();
+        full.flush(frame, b.sink());
+        partial.flush(frame, a.sink());
+
+        TEST_ASSERT_EQUAL_MEMORY(b.ram, a.ram, sizeof(a.ram));
+    }
+    TEST_ASSERT_LESS_THAN(b.bytes / 10, a.bytes); // an order of magnitude less on the bus
+}
+
+// a list of 40 rows under a fixed title, moved by whole pages like MenuView does;
+// scrolling moves the start line, the frame still has to show up unchanged
+void test_scroll_emulation() {
+    PageFlusher scrolling(WIDTH, PAGES * 8), plain(WIDTH, PAGES * 8);
+    Panel a, b;
+    int top = 0;
+
+    auto render = [&top]() {
+        memset(frame, 0x3C, WIDTH); // title
+        for (int p = 1; p < PAGES; p++) {
+            for (int c = 0; c < WIDTH; c++) frame[p * WIDTH + c] = ((top + p) * 37 + c * 11) & 0xFF;
+        }
+    };
+
+    render();
+    scrolling.flush(frame, a.sink());
+    plain.flush(frame, b.sink());
+
+    for (int i = 0; i < 2000; i++) {
+        int from = top;
+        top = (top + (rand() % 3 ? 1 : -1) + 40) % 40;
+        render();
+        if (rand() % 4 == 0) edit();
+
+        if (scrolling.scroll(frame, top - from)) a.start = scrolling.startPage();
+        scrolling.flush(frame, a.sink());
+        plain.flush(frame, b.sink());
+
+        TEST_ASSERT_TRUE(a.shows(frame));
+        TEST_ASSERT_TRUE(b.shows(frame));
+    }
+    TEST_ASSERT_LESS_THAN(b.bytes / 2, a.bytes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_flush_sends_everything);
+    RUN_TEST(test_unchanged_frame_sends_nothing);
+    RUN_TEST(test_invalidate_sends_everything_again);
+    RUN_TEST(test_partial_matches_full_flush);
+    RUN_TEST(test_scroll_emulation);
+    return UNITY_END();
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <Adafruit_SH110X.h>
+#include <unity.h>
+
+#include "displays/pattern_fill.h"
+
+#define SCREENS 500 // per benchmark run
+
+struct Size { int16_t w, h; };
+
+// the panels in use, and odd ones so every phase and a partial last page come up
+static constexpr Size sizes[] = {{128, 64}, {128, 128}, {7, 13}, {13, 7}, {9, 21}, {1, 1}, {3, 8}};
+
+// the slow path PatternFill replaces, pixel by pixel through the rotation
+static void checker(Adafruit_GFX& gfx, uint16_t color) {
+    for (int16_t y = 0; y < gfx.height(); y++) {
+        for (int16_t x = 0; x < gfx.width(); x++) {
+            if ((x + y) & 1) gfx.writePixel(x, y, color);
+        }
+    }
+}
+
+// the same noise in both, so clear and invert have something to work on
+template<typename T>
+static void noise(T* a, T* b, size_t n) {
+    for (size_t i = 0; i < n; i++) a[i] = b[i] = static_cast<T>(rand());
+}
+
+void setUp() { srand(1); }
+void tearDown() {}
+
+void test_pages_match_pixel_loop() {
+    for (const Size& s : sizes) {
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            for (uint16_t color = 0; color < 3; color++) { // clear, set, invert
+                Adafruit_GrayOLED ref(s.w, s.h), fast(s.w, s.h);
+                size_t n = s.w * ((s.h + 7) / 8);
+                noise(ref.getBuffer(), fast.getBuffer(), n);
+                ref.setRotation(rotation);
+
+                checker(ref, color);
+                PatternFill::pages(fast.getBuffer(), s.w, s.h, rotation, color);
+                TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), fast.getBuffer(), n);
+            }
+        }
+    }
+}
+
+void test_bytes_match_pixel_loop() {
+    for (const Size& s : sizes) {
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            GFXcanvas8 ref(s.w, s.h), fast(s.w, s.h);
+            size_t n = s.w * s.h;
+            noise(ref.getBuffer(), fast.getBuffer(), n);
+            ref.setRotation(rotation);
+
+            checker(ref, 0xA5);
+            PatternFill::bytes(fast.getBuffer(), s.w, s.h, rotation, 0xA5);
+            TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), fast.getBuffer(), n);
+        }
+    }
+}
+
+void test_rgb565_match_pixel_loop() {
+    for (const Size& s : sizes) {
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            GFXcanvas16 ref(s.w, s.h), fast(s.w, s.h);
+            size_t n = s.w * s.h;
+            noise(ref.getBuffer(), fast.getBuffer(), n);
+            ref.setRotation(rotation);
+
+            checker(ref, 0x1FF1);
+            PatternFill::rgb565(fast.getBuffer(), s.w, s.h, rotation, 0x1FF1);
+            TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), fast.getBuffer(), n * sizeof(uint16_t));
+        }
+    }
+}
+
+template<typename F>
+static double usPerScreen(F fill) {
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < SCREENS; n++) fill(n);
+    std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+    return took.count() / SCREENS;
+}
+
+void test_shade_benchmark() {
+    Adafruit_GrayOLED mono(128, 64);
+    GFXcanvas16 color(128, 128);
+
+    double mono_loop = usPerScreen([&](int) { checker(mono, 2); });
+    double mono_fill = usPerScreen([&](int) { PatternFill::pages(mono.getBuffer(), 128, 64, 0, 2); });
+    double color_loop = usPerScreen([&](int n) { checker(color, n); });
+    double color_fill = usPerScreen([&](int n) { PatternFill::rgb565(color.getBuffer(), 128, 128, 0, n); });
+
+    char line[96];
+    snprintf(line, sizeof(line), "1-bit 128x64:   pixel loop %7.2f us, fill %7.2f us", mono_loop, mono_fill);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "RGB565 128x128: pixel loop %7.2f us, fill %7.2f us", color_loop, color_fill);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_THAN(mono_loop, mono_fill);
+    TEST_ASSERT_LESS_THAN(color_loop, color_fill);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pages_match_pixel_loop);
+    RUN_TEST(test_bytes_match_pixel_loop);
+    RUN_TEST(test_rgb565_match_pixel_loop);
+    RUN_TEST(test_shade_benchmark);
+    return UNITY_END();
+}
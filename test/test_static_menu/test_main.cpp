@@ -0,0 +1,81 @@
+#include <unity.h>
+
+#include "configuration.h"
+#include "keycodes.h"
+#include "ui/stackers.h"
+#include "ui/static_menu.h"
+
+static int built = 0, entered = 0, left = 0, destroyed = 0, updates = 0;
+
+// records the enter()/leave() protocol a menu is expected to follow
+class Probe : public UIElement {
+public:
+    Probe() { built++; }
+    ~Probe() override { destroyed++; }
+
+    UIElement* enter() override { entered++; return this; }
+    void leave() override { left++; }
+
+    void render(UIContext& ctx, bool minimalized) override { ctx.println("probe"); }
+    bool update(UIContext& ctx, char key) override { updates++; return key == KEY_UP; }
+};
+
+static constexpr MenuEntry entries[] = {
+    MenuEntry::label("Label"),
+    MenuEntry::element('*', "Lazy", []() -> UIElement* {
+        return LazyView::make().title("Lazy").factory([]() -> UIElement* { return new Probe; }).buildPtr();
+    }),
+    MenuEntry::element('*', "Plain", []() -> UIElement* { return new Probe; }),
+};
+static constexpr MenuTable table = MenuTable::of('M', "Static", entries);
+
+static DisplayType screen(128, 64, nullptr, -1);
+static UIContext ctx(screen);
+
+void setUp() { built = entered = left = destroyed = updates = 0; }
+void tearDown() {}
+
+// a factory handing back a LazyView must get its subtree built on enter and freed on leave
+void test_element_entries_are_entered_and_left() {
+    StaticMenu* menu = StaticMenu::make().table(table).buildPtr();
+    menu->render(ctx, false);
+
+    menu->update(ctx, KEY_DOWN);
+    menu->update(ctx, KEY_ENTER);
+    TEST_ASSERT_EQUAL(1, built);
+    TEST_ASSERT_EQUAL(1, entered);
+
+    menu->update(ctx, KEY_UP); // goes to the probe, not the LazyView around it
+    TEST_ASSERT_EQUAL(1, updates);
+
+    menu->update(ctx, KEY_ESC);
+    TEST_ASSERT_EQUAL(1, left);
+    TEST_ASSERT_EQUAL(1, destroyed); // RELEASE policy
+
+    menu->update(ctx, KEY_DOWN);
+    menu->update(ctx, KEY_ENTER);
+    menu->update(ctx, KEY_LEFT);
+    TEST_ASSERT_EQUAL(2, entered);
+    TEST_ASSERT_EQUAL(2, left);
+    TEST_ASSERT_EQUAL(2, destroyed);
+
+    delete menu;
+}
+
+// leaving the menu with an element still open goes through the same protocol
+void test_open_element_is_freed_with_the_menu() {
+    StaticMenu* menu = StaticMenu::make().table(table).buildPtr();
+    menu->update(ctx, KEY_DOWN);
+    menu->update(ctx, KEY_DOWN);
+    menu->update(ctx, KEY_ENTER);
+    TEST_ASSERT_EQUAL(1, entered);
+    delete menu;
+    TEST_ASSERT_EQUAL(1, destroyed);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_element_entries_are_entered_and_left);
+    RUN_TEST(test_open_element_is_freed_with_the_menu);
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <unity.h>
+
+#include "network/tdma.h"
+
+#define SLOTS           8
+#define BEACON_AIRTIME  60000   // about SF9 at 125 kHz
+#define DATA_AIRTIME    400000
+#define JITTER          200     // +- us on every RX timestamp, up to TDMA_JITTER_US
+#define NODES           16      // for the load sweep, one data slot each
+#define LOAD_FRAMES     300
+
+// A node with its own crystal: local = true * (1 + ppm) + offset, wrapping like micros().
+// The coordinator's clock defines network time, so its local time is the true time.
+struct Node {
+    double ppm;
+    double offset;
+    uint8_t slot;
+    TdmaClock clock;
+    TdmaSchedule schedule;
+
+    [[nodiscard]] uint32_t local(double t) const {
+        return static_cast<uint32_t>(static_cast<uint64_t>(std::llround(t * (1 + ppm * 1e-6) + offset)));
+    }
+};
+
+static uint32_t noise = 1;
+static double jitter() {
+    noise = noise * 1103515245 + 12345;
+    return static_cast<double>(noise >> 16 & 0xFF) / 255.0 * 2 * JITTER - JITTER;
+}
+
+static uint8_t slots;
+static uint32_t slot_us, frame_us;
+
+// what NetManager::onBeacon() does with beacon k, sent at true time k * frame
+static void beacon(Node& n, uint16_t k) {
+    double start = static_cast<double>(k) * frame_us;
+    double done = start + BEACON_AIRTIME;
+    double prev_done = done - frame_us;
+
+    uint32_t rx = n.local(done + jitter());
+    n.clock.precise(k, rx, k - 1, static_cast<uint32_t>(static_cast<uint64_t>(prev_done)));
+    n.clock.coarse(rx, static_cast<uint32_t>(static_cast<uint64_t>(start + BEACON_AIRTIME)));
+    n.schedule.configure(slots, slot_us);
+    n.schedule.assign(n.slot);
+    n.schedule.anchor(static_cast<uint32_t>(static_cast<uint64_t>(start)), k);
+}
+
+static double error(const Node& n, double t) {
+    uint32_t network = n.clock.toNetwork(n.local(t));
+    return std::fabs(static_cast<double>(static_cast<int32_t>(network - static_cast<uint32_t>(static_cast<uint64_t>(t)))));
+}
+
+// first true time in frame k at which the node's schedule lets it start DATA_AIRTIME, -1 if none
+static double firstSend(const Node& n, uint16_t k) {
+    double slot = static_cast<double>(k) * frame_us + static_cast<double>(n.slot) * slot_us;
+    for (double t = slot - slot_us / 2.0; t < slot + slot_us; t += 20) { // the window can be a few 100 us
+        uint32_t local = n.local(t);
+        uint32_t guard = TdmaSchedule::guardTime(DATA_AIRTIME, n.clock.uncertainty(local));
+        if (n.schedule.canSend(n.clock.toNetwork(local), DATA_AIRTIME, guard)) return t;
+    }
+    return -1;
+}
+
+// a slow and a fast crystal, the second one about to wrap its 32-bit counter
+static Node a, b;
+
+void setUp() {
+    slots = SLOTS;
+    slot_us = TdmaSchedule::slotLength(DATA_AIRTIME);
+    frame_us = slots * slot_us;
+    noise = 1;
+    a = Node{-35, 123456789, 1};
+    b = Node{+38, 4294967295.0 - 20 * frame_us, 2};
+}
+
+void tearDown() {}
+
+void test_first_beacon_locks_coarsely() {
+    TEST_ASSERT_FALSE(a.clock.synced());
+    beacon(a, 1);
+
+    TEST_ASSERT_TRUE(a.clock.synced());
+    TEST_ASSERT_FALSE(a.clock.tracking());
+    TEST_ASSERT_LESS_THAN(JITTER + 2, error(a, frame_us + BEACON_AIRTIME));
+    TEST_ASSERT_LESS_THAN(a.clock.uncertainty(a.local(2.0 * frame_us)), error(a, 2.0 * frame_us));
+}
+
+void test_two_step_beacons_track_drift() {
+    for (uint16_t k = 1; k <= TDMA_DRIFT_WINDOW; k++) beacon(a, k);
+    TEST_ASSERT_FALSE(a.clock.tracking()); // consecutive samples are mostly jitter
+    TEST_ASSERT_EQUAL(0, a.clock.driftPpm());
+
+    for (uint16_t k = 1; k <= 60; k++) {
+        if (k > TDMA_DRIFT_WINDOW) beacon(a, k);
+        beacon(b, k);
+    }
+    TEST_ASSERT_TRUE(a.clock.tracking());
+    TEST_ASSERT_TRUE(b.clock.tracking());
+
+    // d(network)/d(local) = 1 / (1 + ppm) - 1
+    TEST_ASSERT_FLOAT_WITHIN(TDMA_TRACKED_PPM, 35, a.clock.driftPpm());
+    TEST_ASSERT_FLOAT_WITHIN(TDMA_TRACKED_PPM, -38, b.clock.driftPpm());
+
+    // until a node gives up on the lost coordinator, the estimate stays inside the uncertainty it claims
+    for (double t = 61.0 * frame_us; t < (61.0 + TDMA_SYNC_LOSS) * frame_us; t += frame_us / 16.0) {
+        TEST_ASSERT_LESS_THAN(a.clock.uncertainty(a.local(t)), error(a, t));
+        TEST_ASSERT_LESS_THAN(b.clock.uncertainty(b.local(t)), error(b, t));
+    }
+}
+
+void test_to_local_inverts_to_network() {
+    for (uint16_t k = 1; k <= 10; k++) beacon(b, k);
+
+    for (double t = 10.0 * frame_us; t < 40.0 * frame_us; t += 7777) { // across b's wrap
+        uint32_t local = b.local(t);
+        int32_t back = static_cast<int32_t>(b.clock.toLocal(b.clock.toNetwork(local)) - local);
+        TEST_ASSERT_LESS_OR_EQUAL(2, std::abs(back));
+    }
+}
+
+void test_uncertainty_grows_without_beacons() {
+    for (uint16_t k = 1; k <= 10; k++) beacon(a, k);
+
+    uint32_t now = a.local(10.0 * frame_us + BEACON_AIRTIME);
+    TEST_ASSERT_LESS_THAN(a.clock.uncertainty(now + 10000000), a.clock.uncertainty(now));
+}
+
+// both nodes get to send in every frame, each inside its own slot and never on top of each other
+void test_slots_never_overlap() {
+    for (uint16_t k = 1; k <= 100; k++) {
+        beacon(a, k);
+        beacon(b, k);
+
+        double ta = firstSend(a, k), tb = firstSend(b, k);
+        TEST_ASSERT_TRUE(ta >= 0);
+        TEST_ASSERT_TRUE(tb >= 0);
+
+        double frame = static_cast<double>(k) * frame_us;
+        TEST_ASSERT_TRUE(ta >= frame + a.slot * slot_us && ta + DATA_AIRTIME <= frame + (a.slot + 1) * slot_us);
+        TEST_ASSERT_TRUE(tb >= frame + b.slot * slot_us && tb + DATA_AIRTIME <= frame + (b.slot + 1) * slot_us);
+        TEST_ASSERT_TRUE(ta + DATA_AIRTIME <= tb || tb + DATA_AIRTIME <= ta);
+    }
+}
+
+static double exponential(double mean) {
+    noise = noise * 1103515245 + 12345;
+    return -mean * std::log((static_cast<double>(noise >> 8 & 0xFFFFFF) + 1) / 16777217.0);
+}
+
+// transmissions that nothing else overlaps, in true time
+static uint32_t delivered(std::vector<double> starts) {
+    std::sort(starts.begin(), starts.end());
+    uint32_t ok = 0;
+    double busy_until = -1e18;
+    for (size_t i = 0; i < starts.size(); i++) {
+        bool clear = starts[i] >= busy_until;
+        bool next_clear = i + 1 == starts.size() || starts[i + 1] >= starts[i] + DATA_AIRTIME;
+        ok += clear && next_clear;
+        busy_until = std::max(busy_until, starts[i] + DATA_AIRTIME);
+    }
+    return ok;
+}
+
+// NODES nodes with their own crystals share the channel. The same Poisson traffic goes out once
+// through the TDMA schedule (queued until the node's slot) and once as pure ALOHA (sent on arrival).
+// Offered load G is in airtimes per airtime, like the textbook S = G e^-2G for ALOHA.
+void test_load_sweep_beats_aloha() {
+    slots = NODES + 1;
+    frame_us = slots * slot_us;
+    const double capacity = static_cast<double>(NODES) * DATA_AIRTIME / frame_us; // one frame per node and frame
+    const double start = 2.0 * frame_us, end = static_cast<double>(LOAD_FRAMES) * frame_us;
+    double best_aloha = 0, best_tdma = 0;
+
+    for (double share : {0.15, 0.3, 0.5, 0.7, 0.9}) {
+        const double load = share * capacity;
+        std::vector<Node> nodes;
+        std::vector<std::vector<double>> arrivals(NODES);
+        std::vector<double> aloha;
+        uint32_t offered = 0;
+        for (uint8_t i = 0; i < NODES; i++) {
+            nodes.push_back(Node{(static_cast<int>(i * 37 % 81) - 40) * 1.0, i * 987654321.0, static_cast<uint8_t>(i + 1)});
+            for (double t = start + exponential(DATA_AIRTIME * NODES / load); t < end;
+                 t += exponential(DATA_AIRTIME * NODES / load)) {
+                arrivals[i].push_back(t);
+                aloha.push_back(t);
+                offered++;
+            }
+        }
+
+        std::vector<double> tdma;
+        std::vector<size_t> next(NODES, 0);
+        uint32_t skipped = 0;
+        for (uint16_t k = 1; k < LOAD_FRAMES; k++) {
+            for (uint8_t i = 0; i < NODES; i++) {
+                Node& n = nodes[i];
+                beacon(n, k);
+                if (next[i] == arrivals[i].size() || arrivals[i][next[i]] > (k + 1.0) * frame_us) continue;
+
+                double t = firstSend(n, k);
+                if (t < 0) { // until drift is tracked, late slots are too unsure of the time; waits a frame
+                    skipped++;
+                    continue;
+                }
+                if (arrivals[i][next[i]] > t) continue; // came in after the slot
+                tdma.push_back(t);
+                next[i]++;
+            }
+        }
+
+        uint32_t tdma_ok = delivered(tdma), aloha_ok = delivered(aloha);
+        double span = end - start;
+        double offered_g = offered * static_cast<double>(DATA_AIRTIME) / span;
+        double tdma_s = tdma_ok * static_cast<double>(DATA_AIRTIME) / span;
+        double aloha_s = aloha_ok * static_cast<double>(DATA_AIRTIME) / span;
+        best_aloha = std::max(best_aloha, aloha_s);
+        best_tdma = std::max(best_tdma, tdma_s);
+
+        char line[160];
+        snprintf(line, sizeof(line), "G %.3f: TDMA S %.3f (%u/%u offered, %zu collided, %u slots skipped), ALOHA S %.3f (e^-2G model %.3f)",
+                 offered_g, tdma_s, tdma_ok, offered, tdma.size() - tdma_ok, skipped, aloha_s, offered_g * std::exp(-2 * offered_g));
+        TEST_MESSAGE(line);
+
+        TEST_ASSERT_EQUAL(tdma.size(), tdma_ok);            // slots never collide
+        TEST_ASSERT_GREATER_THAN(offered * 0.95, tdma_ok);  // everything offered gets through below capacity
+        TEST_ASSERT_FLOAT_WITHIN(0.25 * offered_g * std::exp(-2 * offered_g) + 0.01, offered_g * std::exp(-2 * offered_g), aloha_s);
+        TEST_ASSERT_GREATER_THAN(aloha_s, tdma_s);
+        if (offered_g > 0.5) TEST_ASSERT_GREATER_THAN(2 * aloha_s, tdma_s);
+    }
+
+    // at high load TDMA carries several times what ALOHA ever manages (1 / 2e at G = 0.5)
+    TEST_ASSERT_LESS_THAN(1 / (2 * M_E) + 0.02, best_aloha);
+    TEST_ASSERT_GREATER_THAN(3 * best_aloha, best_tdma);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_beacon_locks_coarsely);
+    RUN_TEST(test_two_step_beacons_track_drift);
+    RUN_TEST(test_to_local_inverts_to_network);
+    RUN_TEST(test_uncertainty_grows_without_beacons);
+    RUN_TEST(test_slots_never_overlap);
+    RUN_TEST(test_load_sweep_beats_aloha);
+    return UNITY_END();
+}
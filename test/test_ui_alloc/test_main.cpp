@@ -0,0 +1,88 @@
+#include <alloc_count.h>
+#include <unity.h>
+
+#include "configuration.h"
+#include "keycodes.h"
+#include "ui/base.h"
+#include "ui/inputs.h"
+#include "ui/stackers.h"
+#include "ui/static.h"
+#include "ui/static_menu.h"
+
+#define STEADY_FRAMES 10
+
+static uint8_t number = 5, selected = 1;
+static bool toggled = false;
+static float level = 1.5f;
+static char text[12] = "hello";
+
+static const char* const levels[] = {"Low", "Mid", "High"};
+static constexpr MenuEntry entries[] = {
+    MenuEntry::toggle('*', "Toggle", &toggled),
+    MenuEntry::number('#', "Number", &number, 0, 200, "dB"),
+    MenuEntry::number('#', "A very long float title", &level, 0, 10, 2),
+    MenuEntry::select('>', "Select", &selected, levels),
+    MenuEntry::textField('T', "Text", text, 11),
+    MenuEntry::value("Value", &number, "%u"),
+    MenuEntry::button('!', "Apply all of these", nullptr),
+};
+static constexpr MenuTable table = MenuTable::of('M', "Static", entries);
+
+static UIElement* buildTree() {
+    return MenuView::make().title("[#ff8000]Me[#00ff00]nu").colorized().children({
+        Label::make().title("A fairly long label text here").buildPtr(),
+        Label::make().title("[#ff0000]Colored [[label[]").colorized().buildPtr(),
+        NumberPicker<uint8_t>::make().title("Num").pointer(&number).min(0).max(200).suffix("%").buildPtr(),
+        NumberPicker<float>::make().title("Flt").pointer(&level).min(0).max(10).precision(2).buildPtr(),
+        Toggle::make().title("Tog").pointer(&toggled).buildPtr(),
+        Selector::make().title("Sel").pointer(&selected).items({"one", "two", "three"}).buildPtr(),
+        TextField::make().title("Name").pointer(text).maxLength(11).buildPtr(),
+        StaticMenu::make().table(table).buildPtr(),
+    }).buildPtr();
+}
+
+static bool lit(DisplayType& display) {
+    for (int i = 0; i < display.width() * display.height() / 8; i++) {
+        if (display.getBuffer()[i]) return true;
+    }
+    return false;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// walks the menu and into a few widgets; once a screen is up, redrawing it allocates nothing
+void test_steady_frames_allocate_nothing() {
+    DisplayType display(128, 64, nullptr, -1);
+    UIContext ctx(display);
+    UIApp app = UIApp::make().title("[#4080ff]Test").colorized().root(buildTree()).build();
+
+    const char keys[] = {0, KEY_DOWN, KEY_DOWN, KEY_DOWN, KEY_DOWN, KEY_DOWN, KEY_DOWN, KEY_DOWN,
+                         KEY_ENTER, 0, KEY_DOWN, KEY_DOWN, 0};
+    for (char key : keys) {
+        if (key) app.update(ctx, key);
+        ctx.render(app); // the first frame after a key may open a widget
+        TEST_ASSERT_TRUE(lit(display));
+
+        AllocCount count;
+        for (int i = 0; i < STEADY_FRAMES; i++) {
+            ctx.refresh(i & 1); // full redraws and cell-cached ones
+            ctx.render(app);
+        }
+        TEST_ASSERT_EQUAL_MESSAGE(0, count.allocs(), "allocations in steady frames");
+    }
+}
+
+// the counter itself works, so a zero above means something
+void test_counter_sees_allocations() {
+    AllocCount count;
+    String s("x");
+    TEST_ASSERT_GREATER_THAN(0, count.allocs());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counter_sees_allocations);
+    RUN_TEST(test_steady_frames_allocate_nothing);
+    return UNITY_END();
+}